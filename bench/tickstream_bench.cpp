@@ -0,0 +1,348 @@
+// bench/tickstream_bench.cpp
+//
+// Micro/end-to-end benchmarks. Emits one JSON object per result line (JSON Lines)
+// on stdout so runs can be diffed or loaded into a dataframe.
+//
+//   tickstream_bench [--quick] [--filter <substring>]
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// internal includes
+#include <tickstream/consumer.hpp>
+#include <tickstream/coro.hpp>
+#include <tickstream/params.hpp>
+#include <tickstream/ring_buffer.hpp>
+#include <tickstream/stats.hpp>
+#include <tickstream/stream_gen.hpp>
+#include <tickstream/tick.hpp>
+
+namespace ts = tickstream; // local alias
+namespace co = tickstream::co;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        bool quick = false;
+        std::string filter;
+    };
+
+    Options g_opts;
+
+    template <std::size_t Bytes>
+    struct Blob {
+        std::uint64_t words[Bytes / 8];
+    };
+
+    // prevent the optimizer from discarding benchmark results
+    template <typename T>
+    void do_not_optimize(const T& v) {
+        asm volatile("" : : "r,m"(v) : "memory");
+    }
+
+    bool selected(const std::string& name) {
+        return g_opts.filter.empty() || name.find(g_opts.filter) != std::string::npos;
+    }
+
+    // pin the calling thread; returns false where unsupported or the core does not exist
+    bool pin_to_core(unsigned core) {
+#if defined(__linux__)
+        if (core >= std::thread::hardware_concurrency()) return false;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)core;
+        return false;
+#endif
+    }
+
+    double seconds_since(Clock::time_point t0) {
+        return std::chrono::duration<double>(Clock::now() - t0).count();
+    }
+
+    // one JSON line: {"bench":name, <fields>, "ops":n, "seconds":s, "ops_per_sec":..., "ns_per_op":...}
+    void report(const std::string& name, const std::string& fields, std::uint64_t ops, double seconds) {
+        std::printf("{\"bench\":\"%s\"%s%s,\"ops\":%llu,\"seconds\":%.6f,\"ops_per_sec\":%.1f,\"ns_per_op\":%.3f}\n",
+                    name.c_str(), fields.empty() ? "" : ",", fields.c_str(),
+                    static_cast<unsigned long long>(ops), seconds,
+                    static_cast<double>(ops) / seconds, seconds * 1e9 / static_cast<double>(ops));
+        std::fflush(stdout);
+    }
+
+    std::string field(const char* key, std::uint64_t v) {
+        return "\"" + std::string(key) + "\":" + std::to_string(v);
+    }
+
+    std::string join(std::initializer_list<std::string> parts) {
+        std::string out;
+        for (const auto& p : parts) out += (out.empty() ? "" : ",") + p;
+        return out;
+    }
+
+    // ---------------- RingBuffer ----------------
+
+    template <std::size_t Bytes>
+    void ring_single_thread(std::size_t capacity, std::size_t batch) {
+        const std::string name = batch == 1 ? "ring_st" : "ring_st_bulk";
+        if (!selected(name)) return;
+
+        ts::RingBuffer<Blob<Bytes>> rb(capacity);
+        std::vector<Blob<Bytes>> buf(batch);
+        const std::uint64_t ops = g_opts.quick ? 1u << 20 : 1u << 24;
+
+        const auto t0 = Clock::now();
+        for (std::uint64_t done = 0; done < ops; done += batch) {
+            if (batch == 1) {
+                rb.try_push(buf[0]);
+                rb.try_pop(buf[0]);
+            } else {
+                rb.try_push_n(buf);
+                rb.try_pop_n(buf);
+            }
+        }
+        do_not_optimize(buf[0]);
+        report(name, join({field("elem_bytes", Bytes), field("capacity", capacity), field("batch", batch)}),
+               ops, seconds_since(t0));
+    }
+
+    template <std::size_t Bytes>
+    void ring_cross_core(std::size_t capacity, std::size_t batch) {
+        const std::string name = batch == 1 ? "ring_mt" : "ring_mt_bulk";
+        if (!selected(name)) return;
+
+        ts::RingBuffer<Blob<Bytes>> rb(capacity);
+        const std::uint64_t ops = g_opts.quick ? 1u << 20 : 1u << 24;
+        std::atomic<bool> pinned{true};
+
+        std::thread consumer([&] {
+            pinned = pin_to_core(1) && pinned;
+            std::vector<Blob<Bytes>> out(batch);
+            for (std::uint64_t got = 0; got < ops;) {
+                const std::size_t n = batch == 1 ? (rb.try_pop(out[0]) ? 1 : 0) : rb.try_pop_n(out);
+                if (n == 0) std::this_thread::yield(); else got += n;
+            }
+            do_not_optimize(out[0]);
+        });
+
+        pinned = pin_to_core(0) && pinned;
+        std::vector<Blob<Bytes>> in(batch);
+        const auto t0 = Clock::now();
+        for (std::uint64_t sent = 0; sent < ops;) {
+            const std::size_t n = batch == 1 ? (rb.try_push(in[0]) ? 1 : 0)
+                                             : rb.try_push_n(std::span<const Blob<Bytes>>(in.data(), std::min<std::uint64_t>(batch, ops - sent)));
+            if (n == 0) std::this_thread::yield(); else sent += n;
+        }
+        consumer.join();
+        report(name, join({field("elem_bytes", Bytes), field("capacity", capacity), field("batch", batch),
+                           "\"pinned\":" + std::string(pinned ? "true" : "false")}),
+               ops, seconds_since(t0));
+    }
+
+    // ---------------- StreamGen ----------------
+
+    void stream_gen(std::size_t symbols) {
+        if (!selected("stream_gen")) return;
+
+        ts::Params params;
+        params.symbols.clear();
+        for (std::size_t i = 0; i < symbols; ++i) params.symbols.push_back("SYM" + std::to_string(i));
+        params.seed = 1;
+        params.rate_hz = 1000.0;
+        ts::StreamGen gen(params);
+
+        std::vector<ts::FlatTick> batch(std::max<std::size_t>(symbols, 1024));
+        const std::uint64_t ops = (g_opts.quick ? 1u << 20 : 1u << 23) / batch.size() * batch.size();
+        const auto t0 = Clock::now();
+        for (std::uint64_t done = 0; done < ops; done += batch.size()) gen.next_batch(batch);
+        do_not_optimize(batch[0].price);
+        report("stream_gen", field("symbols", symbols), ops, seconds_since(t0));
+    }
+
+    // correlated shocks: a k-factor model (k > 0) or a full correlation matrix (k == 0)
+    void stream_gen_correlated(std::size_t symbols, std::size_t factors) {
+        if (!selected("stream_gen_correlated")) return;
+
+        ts::Params params;
+        params.symbols.clear();
+        for (std::size_t i = 0; i < symbols; ++i) params.symbols.push_back("SYM" + std::to_string(i));
+        params.seed = 1;
+        params.rate_hz = 1000.0;
+        if (factors != 0) {
+            params.factor_count = factors;
+            params.factor_loadings.assign(symbols * factors, 0.9 / std::sqrt(static_cast<double>(factors)));
+        } else {
+            params.correlation.assign(symbols * symbols, 0.5);
+            for (std::size_t i = 0; i < symbols; ++i) params.correlation[i * symbols + i] = 1.0;
+        }
+        ts::StreamGen gen(params);
+
+        std::vector<ts::FlatTick> batch(std::max<std::size_t>(symbols, 1024));
+        const std::uint64_t ops = (g_opts.quick ? 1u << 20 : 1u << 23) / batch.size() * batch.size();
+        const auto t0 = Clock::now();
+        for (std::uint64_t done = 0; done < ops; done += batch.size()) gen.next_batch(batch);
+        do_not_optimize(batch[0].price);
+        report("stream_gen_correlated", join({field("symbols", symbols), field("factors", factors)}), ops, seconds_since(t0));
+    }
+
+    // ---------------- Coroutine pipeline ----------------
+
+    // generator -> `stages` relay stages -> sink, all on one executor thread
+    void coro_pipeline(std::size_t stages) {
+        if (!selected("coro_pipeline")) return;
+
+        ts::Params params;
+        params.symbols = {"A", "B", "C", "D"};
+        params.seed = 1;
+        params.max_count = g_opts.quick ? 1u << 18 : 1u << 21;
+        ts::StreamGen gen(params);
+
+        std::vector<std::unique_ptr<co::Channel<ts::FlatTick>>> pipes;
+        for (std::size_t i = 0; i <= stages; ++i) pipes.push_back(std::make_unique<co::Channel<ts::FlatTick>>(256));
+
+        co::Executor ex;
+        ex.spawn([](ts::StreamGen& gen, co::Channel<ts::FlatTick>& out) -> co::Task {
+            co::TickSource source(gen, 64);
+            for (auto batch = co_await source.next(); !batch.empty(); batch = co_await source.next()) co_await out.push(batch);
+            out.close();
+        }(gen, *pipes.front()));
+        for (std::size_t i = 0; i < stages; ++i) {
+            ex.spawn([](co::Channel<ts::FlatTick>& in, co::Channel<ts::FlatTick>& out) -> co::Task {
+                std::array<ts::FlatTick, 64> buf;
+                while (std::size_t n = co_await in.pop(buf)) co_await out.push(std::span<const ts::FlatTick>(buf.data(), n));
+                out.close();
+            }(*pipes[i], *pipes[i + 1]));
+        }
+        double sink = 0.0;
+        ex.spawn([](co::Channel<ts::FlatTick>& in, double& sink) -> co::Task {
+            std::array<ts::FlatTick, 64> buf;
+            while (std::size_t n = co_await in.pop(buf)) sink += buf[n - 1].price;
+        }(*pipes.back(), sink));
+
+        const auto t0 = Clock::now();
+        ex.run();
+        do_not_optimize(sink);
+        report("coro_pipeline", field("stages", stages), params.max_count, seconds_since(t0));
+    }
+
+    // ---------------- Consumer dispatch ----------------
+
+    void consumer_dispatch(std::size_t handlers) {
+        if (!selected("consumer_dispatch")) return;
+
+        ts::RingBuffer<ts::FlatTick> rb(4096);
+        ts::Consumer<ts::FlatTick> consumer;
+        double sink = 0.0;
+        for (std::size_t h = 0; h < handlers; ++h) consumer.subscribe([&](const ts::FlatTick& t) { sink += t.price; });
+
+        std::vector<ts::FlatTick> fill(4096, ts::to_flat(ts::tick_btc()));
+        const std::uint64_t rounds = g_opts.quick ? 256 : 4096;
+        double seconds = 0.0;
+        for (std::uint64_t r = 0; r < rounds; ++r) {
+            rb.try_push_n(fill);
+            const auto t0 = Clock::now();
+            consumer.process(rb);
+            seconds += seconds_since(t0);
+        }
+        do_not_optimize(sink);
+        report("consumer_dispatch", field("handlers", handlers), rounds * fill.size(), seconds);
+    }
+
+    // ---------------- End-to-end latency ----------------
+
+    void end_to_end_latency(std::uint64_t gap_ns) {
+        if (!selected("e2e_latency")) return;
+
+        ts::RingBuffer<ts::FlatTick> rb(1024);
+        ts::StreamStats stats;
+        const std::uint64_t ops = g_opts.quick ? 100000 : 1000000;
+        std::atomic<bool> running{true};
+        std::atomic<bool> pinned{true};
+
+        ts::Consumer<ts::FlatTick> consumer;
+        consumer.set_stats(stats);
+        std::thread t([&] {
+            pinned = pin_to_core(1) && pinned;
+            consumer.process_continuous(rb, running);
+        });
+
+        pinned = pin_to_core(0) && pinned;
+        ts::FlatTick tick = ts::to_flat(ts::tick_btc());
+        const auto t0 = Clock::now();
+        for (std::uint64_t i = 0; i < ops; ++i) {
+            tick.mono_ts_ns = ts::StreamStats::now_ns();
+            tick.sequence = static_cast<std::uint32_t>(i);
+            while (!rb.try_push(tick)) std::this_thread::yield();
+            const auto next = tick.mono_ts_ns + gap_ns;
+            while (ts::StreamStats::now_ns() < next) {}
+        }
+        while (stats.consumed.load() < ops) std::this_thread::yield();
+        const double seconds = seconds_since(t0);
+        running = false;
+        t.join();
+
+        const auto& h = stats.latency_ns;
+        std::printf("{\"bench\":\"e2e_latency\",\"gap_ns\":%llu,\"pinned\":%s,\"ops\":%llu,\"seconds\":%.6f,"
+                    "\"p50_ns\":%llu,\"p90_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu}\n",
+                    static_cast<unsigned long long>(gap_ns), pinned ? "true" : "false",
+                    static_cast<unsigned long long>(ops), seconds,
+                    static_cast<unsigned long long>(h.percentile(0.5)),
+                    static_cast<unsigned long long>(h.percentile(0.9)),
+                    static_cast<unsigned long long>(h.percentile(0.99)),
+                    static_cast<unsigned long long>(h.percentile(0.999)),
+                    static_cast<unsigned long long>(h.max()));
+        std::fflush(stdout);
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            g_opts.quick = true;
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            g_opts.filter = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--quick] [--filter <substring>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (std::size_t capacity : {1024u, 65536u}) {
+        ring_single_thread<8>(capacity, 1);
+        ring_single_thread<64>(capacity, 1);
+        ring_single_thread<sizeof(ts::FlatTick)>(capacity, 1);
+        ring_single_thread<64>(capacity, 32);
+        ring_cross_core<8>(capacity, 1);
+        ring_cross_core<64>(capacity, 1);
+        ring_cross_core<sizeof(ts::FlatTick)>(capacity, 1);
+        ring_cross_core<64>(capacity, 32);
+    }
+
+    for (std::size_t symbols : {1u, 16u, 256u, 4096u}) stream_gen(symbols);
+    for (std::size_t factors : {1u, 8u}) stream_gen_correlated(4096, factors);
+    for (std::size_t symbols : {256u, 1024u}) stream_gen_correlated(symbols, 0);
+    for (std::size_t handlers : {1u, 4u}) consumer_dispatch(handlers);
+    for (std::size_t stages : {1u, 16u, 256u}) coro_pipeline(stages);
+    for (std::uint64_t gap_ns : {1000u, 10000u}) end_to_end_latency(gap_ns);
+
+    return 0;
+}
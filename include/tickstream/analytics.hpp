@@ -0,0 +1,530 @@
+// include/tickstream/analytics.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "symbols.hpp"
+#include "tick.hpp"
+
+namespace tickstream {
+
+    /* Incremental per-symbol analytics.
+     *
+     * Every operator keeps its state as flat columns indexed by SymbolId (grown on
+     * first sight of an id) and does O(1) work per tick. Each one takes a single
+     * tick, a span of ticks, or, where the update has no per-symbol history, a
+     * dense column path over a contiguous id range whose loop carries no branches
+     * and vectorizes. Operators are callable, so they plug into a Consumer with
+     * consumer.subscribe(std::ref(op)).
+     *
+     * Works with FlatTick (symbol_id) and Tick (symbol, interned per tick). */
+
+    namespace detail {
+        template<typename T>
+        SymbolId symbol_of(const T& t) {
+            if constexpr (requires { t.symbol_id; }) {
+                return t.symbol_id;
+            } else {
+                return SymbolRegistry::global().intern(t.symbol);
+            }
+        }
+
+        inline constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    } // namespace detail
+
+    /* ---------------- bars ---------------- */
+
+    enum class BarKind : std::uint8_t { Time, Volume, Tick };
+
+    struct Bar {
+        SymbolId symbol_id;
+        std::uint32_t ticks;
+        double open;
+        double high;
+        double low;
+        double close;
+        double volume;
+        double vwap;
+        std::uint64_t start_ns;           // unix_ts_ns of the first tick (Time: bucket start)
+        std::uint64_t end_ns;             // unix_ts_ns of the last tick
+    };
+
+    /// OHLCV bars per symbol. Time bars are aligned to multiples of the interval on
+    /// unix_ts_ns and close when a tick lands in a later bucket (empty buckets emit
+    /// nothing); volume and tick bars close on the tick that reaches the threshold.
+    class BarBuilder {
+    public:
+        using Callback = std::function<void(const Bar&)>;
+
+        static BarBuilder time(std::chrono::nanoseconds interval, Callback on_bar) {
+            if (interval.count() <= 0) throw std::invalid_argument("BarBuilder: interval must be > 0");
+            return BarBuilder(BarKind::Time, static_cast<double>(interval.count()), std::move(on_bar));
+        }
+
+        static BarBuilder volume(double per_bar, Callback on_bar) {
+            if (per_bar <= 0.0) throw std::invalid_argument("BarBuilder: volume per bar must be > 0");
+            return BarBuilder(BarKind::Volume, per_bar, std::move(on_bar));
+        }
+
+        static BarBuilder ticks(std::uint32_t per_bar, Callback on_bar) {
+            if (per_bar == 0) throw std::invalid_argument("BarBuilder: ticks per bar must be > 0");
+            return BarBuilder(BarKind::Tick, per_bar, std::move(on_bar));
+        }
+
+        BarKind kind() const { return kind_; }
+
+        template<typename T>
+        void update(const T& t) {
+            const SymbolId id = detail::symbol_of(t);
+            ensure(id);
+            const std::uint64_t ts = t.unix_ts_ns;
+
+            if (kind_ == BarKind::Time) {
+                const std::uint64_t bucket = ts / interval_ns_;
+                if (ticks_[id] != 0 && bucket != bucket_[id]) close(id);
+                if (ticks_[id] == 0) {
+                    bucket_[id] = bucket;
+                    start_ns_[id] = bucket * interval_ns_;
+                }
+            } else if (ticks_[id] == 0) {
+                start_ns_[id] = ts;
+            }
+
+            add(id, t.price, t.volume, ts);
+
+            if ((kind_ == BarKind::Volume && volume_[id] >= size_) ||
+                (kind_ == BarKind::Tick && ticks_[id] >= size_)) {
+                close(id);
+            }
+        }
+
+        template<typename T>
+        void update(std::span<const T> ticks) {
+            for (const auto& t : ticks) update(t);
+        }
+
+        template<typename T>
+        void operator()(const T& t) { update(t); }
+
+        // the bar still being built, if any
+        std::optional<Bar> current(SymbolId id) const {
+            if (id >= ticks_.size() || ticks_[id] == 0) return std::nullopt;
+            return snapshot(id);
+        }
+
+        // emit every partially built bar (end of session / shutdown)
+        void flush() {
+            for (SymbolId id = 0; id < ticks_.size(); ++id) {
+                if (ticks_[id] != 0) close(id);
+            }
+        }
+
+    private:
+        BarBuilder(BarKind kind, double size, Callback on_bar)
+            : kind_(kind)
+            , size_(size)
+            , interval_ns_(kind == BarKind::Time ? static_cast<std::uint64_t>(size) : 1)
+            , on_bar_(std::move(on_bar)) {}
+
+        void ensure(SymbolId id) {
+            if (id < ticks_.size()) return;
+            const std::size_t n = std::size_t{id} + 1;
+            open_.resize(n); high_.resize(n); low_.resize(n); close_.resize(n);
+            volume_.resize(n); pv_.resize(n); ticks_.resize(n);
+            start_ns_.resize(n); end_ns_.resize(n); bucket_.resize(n);
+        }
+
+        void add(SymbolId id, double price, double volume, std::uint64_t ts) {
+            if (ticks_[id] == 0) {
+                open_[id] = high_[id] = low_[id] = price;
+                volume_[id] = pv_[id] = 0.0;
+            }
+            high_[id] = std::max(high_[id], price);
+            low_[id] = std::min(low_[id], price);
+            close_[id] = price;
+            volume_[id] += volume;
+            pv_[id] += price * volume;
+            end_ns_[id] = ts;
+            ++ticks_[id];
+        }
+
+        Bar snapshot(SymbolId id) const {
+            return Bar{id, ticks_[id], open_[id], high_[id], low_[id], close_[id], volume_[id],
+                       volume_[id] > 0.0 ? pv_[id] / volume_[id] : close_[id], start_ns_[id], end_ns_[id]};
+        }
+
+        void close(SymbolId id) {
+            const Bar bar = snapshot(id);
+            ticks_[id] = 0;
+            if (on_bar_) on_bar_(bar);
+        }
+
+        BarKind kind_;
+        double size_;
+        std::uint64_t interval_ns_;
+        Callback on_bar_;
+
+        std::vector<double> open_, high_, low_, close_, volume_, pv_;
+        std::vector<std::uint32_t> ticks_;
+        std::vector<std::uint64_t> start_ns_, end_ns_, bucket_;
+    };
+
+    /* ---------------- VWAP ---------------- */
+
+    /// Cumulative volume-weighted average price since construction or reset().
+    class Vwap {
+    public:
+        template<typename T>
+        void update(const T& t) {
+            const SymbolId id = detail::symbol_of(t);
+            ensure(id);
+            pv_[id] += t.price * t.volume;
+            v_[id] += t.volume;
+        }
+
+        template<typename T>
+        void update(std::span<const T> ticks) {
+            for (const auto& t : ticks) update(t);
+        }
+
+        template<typename T>
+        void operator()(const T& t) { update(t); }
+
+        // price[k], volume[k] belong to symbol first + k
+        void update_dense(SymbolId first, std::span<const double> price, std::span<const double> volume) {
+            if (price.empty()) return;
+            ensure(static_cast<SymbolId>(first + price.size() - 1));
+            double* pv = pv_.data() + first;
+            double* v = v_.data() + first;
+            for (std::size_t k = 0; k < price.size(); ++k) {
+                pv[k] += price[k] * volume[k];
+                v[k] += volume[k];
+            }
+        }
+
+        // NaN before any volume
+        double value(SymbolId id) const {
+            return id < v_.size() && v_[id] > 0.0 ? pv_[id] / v_[id] : detail::nan;
+        }
+
+        double volume(SymbolId id) const { return id < v_.size() ? v_[id] : 0.0; }
+
+        void reset() {
+            std::fill(pv_.begin(), pv_.end(), 0.0);
+            std::fill(v_.begin(), v_.end(), 0.0);
+        }
+
+    private:
+        void ensure(SymbolId id) {
+            if (id < v_.size()) return;
+            pv_.resize(std::size_t{id} + 1, 0.0);
+            v_.resize(std::size_t{id} + 1, 0.0);
+        }
+
+        std::vector<double> pv_, v_;
+    };
+
+    /* ---------------- EWMA ---------------- */
+
+    namespace detail {
+        // exponentially weighted mean m and variance v of x:
+        //   d = x - m;  m += a*d;  v = (1 - a)*(v + a*d^2)
+        // s is 0 before the first sample, which then seeds m = x, v = 0 (folded into
+        // the weight, so the update stays branch-free)
+        inline void ewma_step(double& m, double& v, double& s, double x, double alpha) {
+            const double w = 1.0 - s * (1.0 - alpha); // 1 on the first sample
+            const double d = x - m;
+            m += w * d;
+            v = (1.0 - w) * (v + w * d * d);
+            s = 1.0;
+        }
+
+        inline double ewma_alpha(double half_life, const char* who) {
+            if (half_life <= 0.0) throw std::invalid_argument(std::string(who) + ": half_life must be > 0");
+            return 1.0 - std::exp2(-1.0 / half_life); // weight halves every half_life samples
+        }
+    } // namespace detail
+
+    /// Exponentially weighted mean and variance of the price level (a smoothed
+    /// price and its dispersion, not a volatility; see EwmaVolatility).
+    class EwmaPrice {
+    public:
+        explicit EwmaPrice(double alpha) : alpha_(alpha) {
+            if (!(alpha > 0.0 && alpha <= 1.0)) throw std::invalid_argument("EwmaPrice: alpha must be in (0, 1]");
+        }
+
+        // weight halves every half_life ticks
+        static EwmaPrice with_half_life(double half_life) { return EwmaPrice(detail::ewma_alpha(half_life, "EwmaPrice")); }
+
+        template<typename T>
+        void update(const T& t) {
+            const SymbolId id = detail::symbol_of(t);
+            ensure(id);
+            detail::ewma_step(mean_[id], var_[id], seen_[id], t.price, alpha_);
+        }
+
+        template<typename T>
+        void update(std::span<const T> ticks) {
+            for (const auto& t : ticks) update(t);
+        }
+
+        template<typename T>
+        void operator()(const T& t) { update(t); }
+
+        // price[k] belongs to symbol first + k
+        void update_dense(SymbolId first, std::span<const double> price) {
+            if (price.empty()) return;
+            ensure(static_cast<SymbolId>(first + price.size() - 1));
+            double* m = mean_.data() + first;
+            double* v = var_.data() + first;
+            double* s = seen_.data() + first;
+            for (std::size_t k = 0; k < price.size(); ++k) detail::ewma_step(m[k], v[k], s[k], price[k], alpha_);
+        }
+
+        double alpha() const { return alpha_; }
+        double mean(SymbolId id) const { return seen(id) ? mean_[id] : detail::nan; }
+        double variance(SymbolId id) const { return seen(id) ? var_[id] : detail::nan; }
+        double stddev(SymbolId id) const { return std::sqrt(variance(id)); }
+
+    private:
+        bool seen(SymbolId id) const { return id < seen_.size() && seen_[id] != 0.0; }
+
+        void ensure(SymbolId id) {
+            if (id < seen_.size()) return;
+            mean_.resize(std::size_t{id} + 1, 0.0);
+            var_.resize(std::size_t{id} + 1, 0.0);
+            seen_.resize(std::size_t{id} + 1, 0.0);
+        }
+
+        double alpha_;
+        std::vector<double> mean_, var_, seen_;
+    };
+
+    /// EWMA volatility: the exponentially weighted standard deviation of log
+    /// returns of price, the decaying-weight counterpart of RollingVolatility.
+    /// Returns use the previous price of the same symbol, so there is no dense path.
+    class EwmaVolatility {
+    public:
+        explicit EwmaVolatility(double alpha) : alpha_(alpha) {
+            if (!(alpha > 0.0 && alpha <= 1.0)) throw std::invalid_argument("EwmaVolatility: alpha must be in (0, 1]");
+        }
+
+        // weight halves every half_life returns
+        static EwmaVolatility with_half_life(double half_life) {
+            return EwmaVolatility(detail::ewma_alpha(half_life, "EwmaVolatility"));
+        }
+
+        template<typename T>
+        void update(const T& t) {
+            const SymbolId id = detail::symbol_of(t);
+            ensure(id);
+            if (!(last_[id] > 0.0)) { // first price of this symbol
+                last_[id] = t.price;
+                return;
+            }
+            const double r = std::log(t.price / last_[id]);
+            last_[id] = t.price;
+            detail::ewma_step(mean_[id], var_[id], seen_[id], r, alpha_);
+            ++count_[id];
+        }
+
+        template<typename T>
+        void update(std::span<const T> ticks) {
+            for (const auto& t : ticks) update(t);
+        }
+
+        template<typename T>
+        void operator()(const T& t) { update(t); }
+
+        double alpha() const { return alpha_; }
+        std::size_t samples(SymbolId id) const { return id < count_.size() ? count_[id] : 0; }
+
+        // per-tick volatility; NaN with fewer than two returns
+        double value(SymbolId id) const { return samples(id) < 2 ? detail::nan : std::sqrt(var_[id]); }
+
+        // EWMA of the log returns themselves; NaN before the first return
+        double mean_return(SymbolId id) const { return samples(id) < 1 ? detail::nan : mean_[id]; }
+
+    private:
+        void ensure(SymbolId id) {
+            if (id < last_.size()) return;
+            const std::size_t n = std::size_t{id} + 1;
+            last_.resize(n, 0.0);
+            mean_.resize(n, 0.0);
+            var_.resize(n, 0.0);
+            seen_.resize(n, 0.0);
+            count_.resize(n, 0);
+        }
+
+        double alpha_;
+        std::vector<double> last_, mean_, var_, seen_;
+        std::vector<std::size_t> count_;
+    };
+
+    /* ---------------- rolling volatility ---------------- */
+
+    /// Sample standard deviation of the last `window` log returns of price.
+    ///
+    /// Returns live in one flat array, `window` slots per symbol, with running sums
+    /// updated in O(1); the sums are recomputed exactly each time a symbol's ring
+    /// wraps so rounding cannot accumulate.
+    class RollingVolatility {
+    public:
+        explicit RollingVolatility(std::size_t window) : window_(window) {
+            if (window < 2) throw std::invalid_argument("RollingVolatility: window must be >= 2");
+        }
+
+        template<typename T>
+        void update(const T& t) {
+            const SymbolId id = detail::symbol_of(t);
+            ensure(id);
+            if (!(last_[id] > 0.0)) { // first price of this symbol
+                last_[id] = t.price;
+                return;
+            }
+            const double r = std::log(t.price / last_[id]);
+            last_[id] = t.price;
+
+            double* ring = returns_.data() + std::size_t{id} * window_;
+            std::size_t& head = head_[id];
+            if (count_[id] == window_) {
+                const double old = ring[head];
+                sum_[id] -= old;
+                sumsq_[id] -= old * old;
+            } else {
+                ++count_[id];
+            }
+            ring[head] = r;
+            sum_[id] += r;
+            sumsq_[id] += r * r;
+
+            if (++head == window_) {
+                head = 0;
+                double s = 0.0, sq = 0.0;
+                for (std::size_t k = 0; k < count_[id]; ++k) { s += ring[k]; sq += ring[k] * ring[k]; }
+                sum_[id] = s;
+                sumsq_[id] = sq;
+            }
+        }
+
+        template<typename T>
+        void update(std::span<const T> ticks) {
+            for (const auto& t : ticks) update(t);
+        }
+
+        template<typename T>
+        void operator()(const T& t) { update(t); }
+
+        std::size_t window() const { return window_; }
+        std::size_t samples(SymbolId id) const { return id < count_.size() ? count_[id] : 0; }
+
+        // per-tick volatility; NaN with fewer than two returns
+        double value(SymbolId id) const {
+            const std::size_t n = samples(id);
+            if (n < 2) return detail::nan;
+            const double mean = sum_[id] / static_cast<double>(n);
+            const double var = (sumsq_[id] - mean * sum_[id]) / static_cast<double>(n - 1);
+            return std::sqrt(std::max(var, 0.0));
+        }
+
+    private:
+        void ensure(SymbolId id) {
+            if (id < last_.size()) return;
+            const std::size_t n = std::size_t{id} + 1;
+            returns_.resize(n * window_, 0.0);
+            last_.resize(n, 0.0);
+            sum_.resize(n, 0.0);
+            sumsq_.resize(n, 0.0);
+            count_.resize(n, 0);
+            head_.resize(n, 0);
+        }
+
+        std::size_t window_;
+        std::vector<double> returns_;
+        std::vector<double> last_, sum_, sumsq_;
+        std::vector<std::size_t> count_, head_;
+    };
+
+    /* ---------------- spread ---------------- */
+
+    /// Quoted spread (ask - bid): last, mean, min and max per symbol.
+    class SpreadStats {
+    public:
+        template<typename T>
+        void update(const T& t) {
+            const SymbolId id = detail::symbol_of(t);
+            ensure(id);
+            step(id, t.ask - t.bid);
+        }
+
+        template<typename T>
+        void update(std::span<const T> ticks) {
+            for (const auto& t : ticks) update(t);
+        }
+
+        template<typename T>
+        void operator()(const T& t) { update(t); }
+
+        // bid[k], ask[k] belong to symbol first + k
+        void update_dense(SymbolId first, std::span<const double> bid, std::span<const double> ask) {
+            if (bid.empty()) return;
+            ensure(static_cast<SymbolId>(first + bid.size() - 1));
+            double* last = last_.data() + first;
+            double* sum = sum_.data() + first;
+            double* lo = min_.data() + first;
+            double* hi = max_.data() + first;
+            double* n = count_.data() + first;
+            for (std::size_t k = 0; k < bid.size(); ++k) {
+                const double s = ask[k] - bid[k];
+                last[k] = s;
+                sum[k] += s;
+                lo[k] = std::min(lo[k], s);
+                hi[k] = std::max(hi[k], s);
+                n[k] += 1.0;
+            }
+        }
+
+        double last(SymbolId id) const { return has(id) ? last_[id] : detail::nan; }
+        double mean(SymbolId id) const { return has(id) ? sum_[id] / count_[id] : detail::nan; }
+        double min(SymbolId id) const { return has(id) ? min_[id] : detail::nan; }
+        double max(SymbolId id) const { return has(id) ? max_[id] : detail::nan; }
+        std::uint64_t count(SymbolId id) const { return has(id) ? static_cast<std::uint64_t>(count_[id]) : 0; }
+
+    private:
+        bool has(SymbolId id) const { return id < count_.size() && count_[id] > 0.0; }
+
+        void step(SymbolId id, double s) {
+            last_[id] = s;
+            sum_[id] += s;
+            min_[id] = std::min(min_[id], s);
+            max_[id] = std::max(max_[id], s);
+            count_[id] += 1.0;
+        }
+
+        void ensure(SymbolId id) {
+            if (id < count_.size()) return;
+            const std::size_t n = std::size_t{id} + 1;
+            last_.resize(n, 0.0);
+            sum_.resize(n, 0.0);
+            min_.resize(n, std::numeric_limits<double>::infinity());
+            max_.resize(n, -std::numeric_limits<double>::infinity());
+            count_.resize(n, 0.0);
+        }
+
+        // count kept as double so the dense loop is a single type
+        std::vector<double> last_, sum_, min_, max_, count_;
+    };
+
+} // namespace tickstream
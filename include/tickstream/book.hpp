@@ -0,0 +1,358 @@
+// include/tickstream/book.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "params.hpp"
+#include "symbols.hpp"
+#include "tick.hpp"
+#include "detail/models.hpp"
+#include "detail/rng.h"
+
+namespace tickstream {
+
+    enum class Side : std::uint8_t { Bid, Ask };
+    enum class BookAction : std::uint8_t { Add, Modify, Delete, Clear };
+
+    /* Incremental L2 depth. Instead of copying the whole book with every tick, a
+     * producer sends one 32-byte BookDelta per level change and a full refresh
+     * (Clear followed by one Add per level, flagged snapshot) every so often, so a
+     * late joiner or a consumer that lost a delta can resynchronize. */
+
+    struct BookDelta {
+        std::uint64_t mono_ts_ns;       // monotonic timestamp (steady_clock)
+        double qty;
+        std::int32_t price_ticks;       // price / Params::tick_size
+        SymbolId symbol_id;             // see SymbolRegistry
+        std::uint32_t sequence;         // per symbol, +1 per delta; a gap means a lost delta
+        Side side;
+        BookAction action;
+        std::uint8_t level;             // index the level takes (Add/Modify) or had (Delete)
+        std::uint8_t flags;
+
+        static constexpr std::uint8_t snapshot = 1;       // part of a Clear + Add refresh
+        static constexpr std::uint8_t end_of_batch = 2;   // the book is consistent after this delta
+    };
+
+    static_assert(std::is_trivially_copyable_v<BookDelta>);
+    static_assert(sizeof(BookDelta) == 32);
+
+    /// Fixed-depth L2 book: per side, sorted arrays of grid prices and quantities
+    /// (best level first). Depth is small, so lookups are a short linear scan that
+    /// starts from the delta's level hint.
+    template<std::size_t Depth = 10>
+    class L2Book {
+    public:
+        static_assert(Depth > 0 && Depth <= 255, "L2Book: level index is a uint8_t");
+        static constexpr std::size_t depth = Depth;
+
+        std::size_t levels(Side s) const { return n_[index(s)]; }
+        std::int32_t price_ticks(Side s, std::size_t i) const { return px_[index(s)][i]; }
+        double qty(Side s, std::size_t i) const { return qty_[index(s)][i]; }
+        bool empty() const { return n_[0] == 0 && n_[1] == 0; }
+
+        // false if the delta does not fit this book (unknown level, or worse than a full side)
+        bool apply(const BookDelta& d) {
+            const std::size_t s = index(d.side);
+            switch (d.action) {
+            case BookAction::Clear:
+                n_ = {0, 0};
+                return true;
+            case BookAction::Add:
+                return insert(d.side, d.price_ticks, d.qty, d.level);
+            case BookAction::Modify: {
+                const std::size_t i = find(s, d.price_ticks, d.level);
+                if (i == Depth) return false;
+                qty_[s][i] = d.qty;
+                return true;
+            }
+            case BookAction::Delete: {
+                const std::size_t i = find(s, d.price_ticks, d.level);
+                if (i == Depth) return false;
+                for (std::size_t k = i + 1; k < n_[s]; ++k) {
+                    px_[s][k - 1] = px_[s][k];
+                    qty_[s][k - 1] = qty_[s][k];
+                }
+                --n_[s];
+                return true;
+            }
+            }
+            return false;
+        }
+
+        // top flat_depth levels (and the touch) into a FlatTick
+        void copy_to(FlatTick& t, double tick_size) const {
+            t.n_bids = static_cast<std::uint8_t>(std::min(levels(Side::Bid), flat_depth));
+            t.n_asks = static_cast<std::uint8_t>(std::min(levels(Side::Ask), flat_depth));
+            for (std::size_t i = 0; i < t.n_bids; ++i) t.bids[i] = {px_[0][i] * tick_size, qty_[0][i]};
+            for (std::size_t i = 0; i < t.n_asks; ++i) t.asks[i] = {px_[1][i] * tick_size, qty_[1][i]};
+            if (t.n_bids != 0) t.bid = t.bids[0].price;
+            if (t.n_asks != 0) t.ask = t.asks[0].price;
+        }
+
+        // compares valid levels only
+        friend bool operator==(const L2Book& a, const L2Book& b) {
+            if (a.n_ != b.n_) return false;
+            for (std::size_t s = 0; s < 2; ++s) {
+                for (std::size_t i = 0; i < a.n_[s]; ++i) {
+                    if (a.px_[s][i] != b.px_[s][i] || a.qty_[s][i] != b.qty_[s][i]) return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        static constexpr std::size_t index(Side s) { return s == Side::Bid ? 0 : 1; }
+
+        // bids: higher is better; asks: lower is better
+        static bool better(Side s, std::int32_t a, std::int32_t b) { return s == Side::Bid ? a > b : a < b; }
+
+        std::size_t find(std::size_t s, std::int32_t px, std::size_t hint) const {
+            if (hint < n_[s] && px_[s][hint] == px) return hint;
+            for (std::size_t i = 0; i < n_[s]; ++i) {
+                if (px_[s][i] == px) return i;
+            }
+            return Depth;
+        }
+
+        bool insert(Side side, std::int32_t px, double q, std::size_t hint) {
+            const std::size_t s = index(side);
+            const std::size_t n = n_[s];
+            std::size_t i = hint;
+            const bool hint_fits = hint <= n && (hint == 0 || better(side, px_[s][hint - 1], px))
+                                   && (hint == n || !better(side, px_[s][hint], px));
+            if (!hint_fits) {
+                i = 0;
+                while (i < n && better(side, px_[s][i], px)) ++i;
+            }
+            if (i < n && px_[s][i] == px) { qty_[s][i] = q; return true; }
+            if (i == Depth) return false;
+            for (std::size_t k = std::min(n, Depth - 1); k > i; --k) { // the worst level falls off a full side
+                px_[s][k] = px_[s][k - 1];
+                qty_[s][k] = qty_[s][k - 1];
+            }
+            px_[s][i] = px;
+            qty_[s][i] = q;
+            n_[s] = static_cast<std::uint8_t>(std::min(n + 1, Depth));
+            return true;
+        }
+
+        std::array<std::array<std::int32_t, Depth>, 2> px_{};
+        std::array<std::array<double, Depth>, 2> qty_{};
+        std::array<std::uint8_t, 2> n_{};
+    };
+
+    struct BookOptions {
+        std::uint64_t snapshot_every = 1000;  // updates between full refreshes per symbol (0 => first only)
+        double modify_prob = 0.1;             // chance a resting level changes size per update
+        double mean_qty = 100.0;              // level sizes are exponential lots
+    };
+
+    /// Simulated per-symbol books kept as a dense Depth-level ladder on each side of
+    /// the model's touch. update() moves a book to the new touch and emits only the
+    /// difference: deletes for levels that left the ladder, adds for the new ones,
+    /// and size changes for a random subset of the rest. Each symbol draws from its
+    /// own RNG stream, so its delta sequence depends only on the seed and its quotes.
+    template<std::size_t Depth = 10>
+    class BookSim {
+    public:
+        BookSim(const Params& params, std::vector<SymbolId> ids, std::uint64_t seed, BookOptions options = {})
+            : tick_size_(params.tick_size)
+            , options_(options)
+            , ids_(std::move(ids)) {
+            if (tick_size_ <= 0.0) throw std::invalid_argument("BookSim: tick_size must be > 0");
+            state_.reserve(ids_.size());
+            for (std::size_t i = 0; i < ids_.size(); ++i) state_.push_back(State{{}, detail::RNG(seed, stream_base + i), 0, 0});
+        }
+
+        std::size_t size() const { return state_.size(); }
+        double tick_size() const { return tick_size_; }
+        const L2Book<Depth>& book(std::size_t i) const { return state_[i].book; }
+
+        // move symbol i's book to the new touch; emit(const BookDelta&) once per delta
+        template<typename Emit>
+        void update(std::size_t i, double bid, double ask, std::uint64_t mono_ts_ns, Emit&& emit) {
+            State& s = state_[i];
+            const auto best_bid = static_cast<std::int32_t>(std::llround(bid / tick_size_));
+            const auto best_ask = std::max(static_cast<std::int32_t>(std::llround(ask / tick_size_)), best_bid + 1);
+
+            batch_.clear();
+            const bool refresh = s.updates == 0 || (options_.snapshot_every != 0 && s.updates % options_.snapshot_every == 0);
+            if (refresh) {
+                push(s, i, mono_ts_ns, Side::Bid, BookAction::Clear, 0, 0, 0.0, BookDelta::snapshot);
+                for (std::size_t k = 0; k < Depth; ++k) {
+                    push(s, i, mono_ts_ns, Side::Bid, BookAction::Add, k, best_bid - static_cast<std::int32_t>(k), draw_qty(s), BookDelta::snapshot);
+                }
+                for (std::size_t k = 0; k < Depth; ++k) {
+                    push(s, i, mono_ts_ns, Side::Ask, BookAction::Add, k, best_ask + static_cast<std::int32_t>(k), draw_qty(s), BookDelta::snapshot);
+                }
+            } else {
+                diff(s, i, mono_ts_ns, Side::Bid, best_bid);
+                diff(s, i, mono_ts_ns, Side::Ask, best_ask);
+            }
+            ++s.updates;
+
+            if (batch_.empty()) return;
+            batch_.back().flags |= BookDelta::end_of_batch;
+            for (const auto& d : batch_) emit(d);
+        }
+
+    private:
+        static constexpr std::uint64_t stream_base = std::uint64_t{1} << 47; // disjoint from model streams
+
+        struct State {
+            L2Book<Depth> book;
+            detail::RNG rng;
+            std::uint32_t sequence;
+            std::uint64_t updates;
+        };
+
+        double draw_qty(State& s) {
+            return std::floor(-options_.mean_qty * std::log(1.0 - s.rng.uniform(0.0, 1.0))) + 1.0;
+        }
+
+        void push(State& s, std::size_t i, std::uint64_t ts, Side side, BookAction action, std::size_t level,
+                  std::int32_t px, double qty, std::uint8_t flags) {
+            const BookDelta d{ts, qty, px, ids_[i], s.sequence++, side, action, static_cast<std::uint8_t>(level), flags};
+            s.book.apply(d);
+            batch_.push_back(d);
+        }
+
+        // the ladder is dense: after an update, level k of a side is best +/- k ticks
+        void diff(State& s, std::size_t i, std::uint64_t ts, Side side, std::int32_t best) {
+            const std::int32_t dir = side == Side::Bid ? -1 : 1;
+            const std::int32_t worst = best + dir * static_cast<std::int32_t>(Depth - 1);
+            const auto in_ladder = [&](std::int32_t px) {
+                return side == Side::Bid ? (px <= best && px >= worst) : (px >= best && px <= worst);
+            };
+
+            // back to front so the remaining levels keep their indices
+            for (std::size_t k = s.book.levels(side); k-- > 0;) {
+                const std::int32_t px = s.book.price_ticks(side, k);
+                if (!in_ladder(px)) push(s, i, ts, side, BookAction::Delete, k, px, 0.0, 0);
+            }
+
+            // everything left is inside the ladder, so filling it in order makes level k the k-th rung
+            std::array<bool, Depth> added{};
+            for (std::size_t k = 0; k < Depth; ++k) {
+                const std::int32_t px = best + dir * static_cast<std::int32_t>(k);
+                if (k >= s.book.levels(side) || s.book.price_ticks(side, k) != px) {
+                    push(s, i, ts, side, BookAction::Add, k, px, draw_qty(s), 0);
+                    added[k] = true;
+                }
+            }
+
+            for (std::size_t k = 0; k < Depth; ++k) {
+                if (added[k] || s.rng.uniform(0.0, 1.0) >= options_.modify_prob) continue;
+                push(s, i, ts, side, BookAction::Modify, k, s.book.price_ticks(side, k), draw_qty(s), 0);
+            }
+        }
+
+        double tick_size_;
+        BookOptions options_;
+        std::vector<SymbolId> ids_;
+        std::vector<State> state_;
+        std::vector<BookDelta> batch_; // one update, flagged end_of_batch on its last delta
+    };
+
+    /// Pull generator of book deltas: the multi-symbol model drives the touch of a
+    /// BookSim, one universe step per next_step().
+    template<std::size_t Depth = 10>
+    class BookStream {
+    public:
+        explicit BookStream(const Params& params, BookOptions options = {})
+            : BookStream(params, options, params.seed != 0 ? params.seed
+                                                           : (std::uint64_t{std::random_device{}()} << 32) ^ std::random_device{}()) {}
+
+        // appends every symbol's deltas for one step; returns how many were appended
+        std::size_t next_step(std::vector<BookDelta>& out) {
+            engine_.step();
+            const auto now = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+            const std::size_t before = out.size();
+            for (std::size_t i = 0; i < engine_.size(); ++i) {
+                sim_.update(i, engine_.bid()[i], engine_.ask()[i], now, [&](const BookDelta& d) { out.push_back(d); });
+            }
+            return out.size() - before;
+        }
+
+        const BookSim<Depth>& sim() const { return sim_; }
+
+    private:
+        static std::vector<SymbolId> intern(const Params& params) {
+            if (params.symbols.empty()) throw std::invalid_argument("BookStream: params.symbols is empty");
+            std::vector<SymbolId> ids;
+            ids.reserve(params.symbols.size());
+            for (const auto& s : params.symbols) ids.push_back(SymbolRegistry::global().intern(s));
+            return ids;
+        }
+
+        BookStream(const Params& params, BookOptions options, std::uint64_t seed)
+            : engine_(params, params.symbols.size(), seed)
+            , sim_(params, intern(params), seed, options) {}
+
+        detail::MultiSymbolEngine engine_;
+        BookSim<Depth> sim_;
+    };
+
+    /// Consumer-side books rebuilt in place from deltas, indexed by SymbolId.
+    ///
+    /// A symbol is unsynced until its first Clear; a sequence gap or a delta that
+    /// does not fit the book unsyncs it again until the next snapshot. Use it as a
+    /// Consumer<BookDelta> handler.
+    template<std::size_t Depth = 10>
+    class BookBuilder {
+    public:
+        // false if the delta was not applied
+        bool apply(const BookDelta& d) {
+            if (d.symbol_id >= books_.size()) books_.resize(d.symbol_id + 1);
+            Entry& e = books_[d.symbol_id];
+            if (d.action == BookAction::Clear) {
+                e.synced = true;
+            } else if (!e.synced) {
+                return false;
+            } else if (d.sequence != e.next_sequence) {
+                e.synced = false;
+                ++gaps_;
+                return false;
+            }
+            e.next_sequence = d.sequence + 1;
+            if (!e.book.apply(d)) {
+                e.synced = false;
+                ++gaps_;
+                return false;
+            }
+            return true;
+        }
+
+        void operator()(const BookDelta& d) { apply(d); }
+
+        // throws std::out_of_range for a symbol that never sent a delta
+        const L2Book<Depth>& book(SymbolId id) const { return books_.at(id).book; }
+        bool synced(SymbolId id) const { return id < books_.size() && books_[id].synced; }
+
+        // resyncs forced by lost or inconsistent deltas
+        std::uint64_t gaps() const { return gaps_; }
+
+    private:
+        struct Entry {
+            L2Book<Depth> book;
+            std::uint32_t next_sequence = 0;
+            bool synced = false;
+        };
+
+        std::vector<Entry> books_;
+        std::uint64_t gaps_{0};
+    };
+
+} // namespace tickstream
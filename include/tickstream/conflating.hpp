@@ -0,0 +1,158 @@
+// include/tickstream/conflating.hpp
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "detail/cache_line.hpp"
+#include "detail/cpu_relax.hpp"
+#include "wait_strategy.hpp"
+
+namespace tickstream {
+
+    /// Latest-value-per-slot channel for consumers that only need current state.
+    ///
+    /// Slots (typically one per SymbolId) are guarded by seqlocks, so publish()
+    /// never waits on a reader and a reader never blocks a writer: a torn read is
+    /// detected by the sequence and retried. A dirty bitset records which slots
+    /// changed since the consumer last drained; updates that land on a dirty slot
+    /// replace the pending value (counted by conflated()).
+    ///
+    /// Any number of writers (concurrent writers of the same slot serialize on its
+    /// sequence); one draining consumer. Values are copied as relaxed atomic words,
+    /// so T must be trivially copyable.
+    template<typename T>
+    class ConflatingBuffer {
+        static_assert(std::is_trivially_copyable_v<T>, "ConflatingBuffer: T must be trivially copyable");
+
+    public:
+        explicit ConflatingBuffer(std::size_t slots)
+            : slots_(slots)
+            , slot_(std::make_unique<Slot[]>(slots))
+            , dirty_(std::make_unique<std::atomic<std::uint64_t>[]>(words_for(slots)))
+            , seen_(std::make_unique<std::uint64_t[]>(slots)) {
+            for (std::size_t w = 0; w < words_for(slots); ++w) dirty_[w].store(0, std::memory_order_relaxed);
+        }
+
+        ConflatingBuffer(const ConflatingBuffer&) = delete;
+        ConflatingBuffer& operator=(const ConflatingBuffer&) = delete;
+
+        std::size_t slots() const { return slots_; }
+
+        // signalled after every publish, for a consumer parked in process_continuous()
+        void set_wait_strategy(WaitStrategy& wait) { wait_ = &wait; }
+
+        // overwrite slot's value; false if slot is out of range
+        bool publish(std::size_t slot, const T& value) {
+            if (slot >= slots_) return false;
+            Slot& s = slot_[slot];
+
+            std::uint64_t seq = s.seq.load(std::memory_order_relaxed);
+            for (;;) {
+                if ((seq & 1) == 0 && s.seq.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                                                  std::memory_order_relaxed)) break;
+                detail::cpu_relax();
+                seq = s.seq.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release); // odd sequence before the data
+
+            std::uint64_t words[Slot::words]{};
+            std::memcpy(words, &value, sizeof(T));
+            for (std::size_t w = 0; w < Slot::words; ++w) s.data[w].store(words[w], std::memory_order_relaxed);
+
+            s.seq.store(seq + 2, std::memory_order_release);
+            dirty_[slot / 64].fetch_or(std::uint64_t{1} << (slot % 64), std::memory_order_release);
+            if (wait_) wait_->signal();
+            return true;
+        }
+
+        // keyed by the value's symbol_id
+        bool publish(const T& value) requires requires { value.symbol_id; } {
+            return publish(value.symbol_id, value);
+        }
+
+        // Consumer handler: conflate the fast path's ticks for slow readers
+        void operator()(const T& value) requires requires { value.symbol_id; } { publish(value); }
+
+        // consistent copy of slot's latest value; false if it was never written
+        bool read(std::size_t slot, T& out) const {
+            if (slot >= slots_) return false;
+            return read_slot(slot_[slot], out) != 0;
+        }
+
+        // f(slot, value) once per slot updated since the previous drain, with its
+        // latest value; returns the number of slots visited
+        template<typename F>
+        std::size_t drain(F&& f) {
+            std::size_t n = 0;
+            for (std::size_t w = 0; w < words_for(slots_); ++w) {
+                if (dirty_[w].load(std::memory_order_relaxed) == 0) continue;
+                std::uint64_t bits = dirty_[w].exchange(0, std::memory_order_acquire);
+                while (bits != 0) {
+                    const std::size_t slot = w * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                    bits &= bits - 1;
+
+                    T value;
+                    const std::uint64_t version = read_slot(slot_[slot], value);
+                    if (version == 0) continue;
+                    if (version > seen_[slot] + 1) conflated_ += version - seen_[slot] - 1;
+                    if (version <= seen_[slot]) continue; // already delivered by a previous drain
+                    seen_[slot] = version;
+                    f(slot, static_cast<const T&>(value));
+                    ++n;
+                }
+            }
+            return n;
+        }
+
+        bool empty() const {
+            for (std::size_t w = 0; w < words_for(slots_); ++w) {
+                if (dirty_[w].load(std::memory_order_relaxed) != 0) return false;
+            }
+            return true;
+        }
+
+        // updates overwritten before the consumer saw them (consumer-side count)
+        std::uint64_t conflated() const { return conflated_; }
+
+    private:
+        struct alignas(detail::cache_line_size) Slot {
+            static constexpr std::size_t words = (sizeof(T) + 7) / 8;
+            std::atomic<std::uint64_t> seq{0};        // odd while a write is in progress
+            std::array<std::atomic<std::uint64_t>, words> data{};
+        };
+
+        static constexpr std::size_t words_for(std::size_t slots) { return (slots + 63) / 64; }
+
+        // returns the slot version (writes so far), 0 if never written
+        static std::uint64_t read_slot(const Slot& s, T& out) {
+            std::uint64_t words[Slot::words];
+            for (;;) {
+                const std::uint64_t before = s.seq.load(std::memory_order_acquire);
+                if (before == 0) return 0;
+                if (before & 1) { detail::cpu_relax(); continue; }
+                for (std::size_t w = 0; w < Slot::words; ++w) words[w] = s.data[w].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) == before) {
+                    std::memcpy(&out, words, sizeof(T));
+                    return before / 2;
+                }
+            }
+        }
+
+        std::size_t slots_;
+        std::unique_ptr<Slot[]> slot_;
+        std::unique_ptr<std::atomic<std::uint64_t>[]> dirty_;
+        std::unique_ptr<std::uint64_t[]> seen_;     // consumer: last version delivered per slot
+        std::uint64_t conflated_{0};
+        WaitStrategy* wait_{nullptr};
+    };
+
+} // namespace tickstream
@@ -1,9 +1,21 @@
 // include/tickstream/consumer.hpp
 #pragma once
 
+#include "conflating.hpp"
+#include "detail/cpu_relax.hpp"
+#include "lane_merger.hpp"
+#include "multicast_ring.hpp"
 #include "ring_buffer.hpp"
+#include "stats.hpp"
 #include "tick.hpp"
+#include "wait_strategy.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <thread>
 #include <vector>
 
 namespace tickstream {
@@ -17,24 +29,127 @@ namespace tickstream {
             handlers_.push_back(handler);
         }
         
-        void process(RingBuffer<T>& buffer) {
+        // shared with the producer of the same buffer; signalled after draining
+        void set_wait_strategy(WaitStrategy& wait) {
+            wait_ = &wait;
+        }
+        
+        // optional instrumentation: consumed count, latency from mono_ts_ns, queue depth
+        void set_stats(StreamStats& stats) {
+            stats_ = &stats;
+        }
+        
+        // drains the buffer, returns how many ticks were handled
+        std::size_t process(RingBuffer<T>& buffer) {
+            if (stats_) stats_->depth_high_water.update(buffer.size()); // deepest point is before draining
             T tick;
+            std::size_t n = 0;
             while (buffer.try_pop(tick)) {
+                record(tick);
                 for (auto& handler : handlers_) {
                     handler(tick);
                 }
+                ++n;
+            }
+            if (n != 0) {
+                wait_->signal(); // a blocked producer may proceed
+                if (stats_) stats_->consumed.add(n);
             }
+            return n;
+        }
+        
+        // multicast: this consumer's own cursor, independent of other readers; one
+        // batch of what was published when called, returns how many were handled
+        std::size_t process(MulticastReader<T>& reader) {
+            const std::size_t n = reader.poll([this](const T& tick, std::int64_t, bool) { dispatch(tick); });
+            finish(n);
+            return n;
+        }
+        
+        // fan-in: per-symbol lanes in timestamp order, subject to the merger's reorder window
+        std::size_t process(LaneMerger<T>& merger) {
+            if (stats_) stats_->depth_high_water.update(merger.size());
+            const std::size_t n = merger.poll([this](const T& tick) { dispatch(tick); });
+            finish(n);
+            return n;
         }
         
+        // conflated: the latest value of every slot updated since the last call
+        std::size_t process(ConflatingBuffer<T>& buffer) {
+            const std::size_t n = buffer.drain([this](std::size_t, const T& tick) { dispatch(tick); });
+            if (n != 0 && stats_) stats_->consumed.add(n);
+            return n;
+        }
+        
+        // waits with the configured WaitStrategy whenever the buffer drains; with a
+        // Blocking strategy, call wake_all() on it after clearing running
         void process_continuous(RingBuffer<T>& buffer, std::atomic<bool>& running) {
             while (running) {
-                process(buffer);
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                if (process(buffer) == 0) {
+                    wait_->wait([&] { return !buffer.empty(); }, running);
+                }
+            }
+            process(buffer);
+        }
+        
+        // when the reorder window holds ticks back, sleeps until the earliest is due
+        // instead of polling
+        void process_continuous(LaneMerger<T>& merger, std::atomic<bool>& running) {
+            while (running) {
+                if (process(merger) != 0) continue;
+                if (const std::uint64_t due = merger.release_at_ns(); due != std::numeric_limits<std::uint64_t>::max()) {
+                    wait_until(due, running);
+                } else {
+                    wait_->wait([&] { return !merger.empty(); }, running);
+                }
+            }
+            finish(merger.flush([this](const T& tick) { dispatch(tick); }));
+        }
+        
+        // pair with ConflatingBuffer::set_wait_strategy on the same strategy
+        void process_continuous(ConflatingBuffer<T>& buffer, std::atomic<bool>& running) {
+            while (running) {
+                if (process(buffer) == 0) {
+                    wait_->wait([&] { return !buffer.empty(); }, running);
+                }
             }
+            process(buffer);
         }
 
     private:
+        void dispatch(const T& tick) {
+            record(tick);
+            for (auto& handler : handlers_) {
+                handler(tick);
+            }
+        }
+        
+        // BusySpin keeps spinning; other strategies sleep in slices short enough to see running clear
+        void wait_until(std::uint64_t due_ns, const std::atomic<bool>& running) {
+            for (std::uint64_t now = StreamStats::now_ns(); now < due_ns && running.load(std::memory_order_relaxed);
+                 now = StreamStats::now_ns()) {
+                if (wait_->kind() == WaitKind::BusySpin) detail::cpu_relax();
+                else std::this_thread::sleep_for(std::chrono::nanoseconds(std::min<std::uint64_t>(due_ns - now, 1'000'000)));
+            }
+        }
+
+        void finish(std::size_t n) {
+            if (n != 0) {
+                wait_->signal();
+                if (stats_) stats_->consumed.add(n);
+            }
+        }
+        
+        void record(const T& tick) {
+            if constexpr (requires { tick.mono_ts_ns; }) {
+                if (stats_) stats_->record_latency(tick.mono_ts_ns, StreamStats::now_ns());
+            }
+        }
+
         std::vector<Handler> handlers_;
+        StreamStats* stats_{nullptr};
+        WaitStrategy default_wait_{WaitKind::SpinYield};
+        WaitStrategy* wait_{&default_wait_};
     };
 
 } // namespace tickstream
\ No newline at end of file
@@ -0,0 +1,421 @@
+// include/tickstream/coro.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/cpu_relax.hpp"
+#include "ring_buffer.hpp"
+#include "stream_gen.hpp"
+#include "tick.hpp"
+
+namespace tickstream::co {
+
+    /* Coroutine pipelines.
+     *
+     * A stage is a coroutine returning co::Task; an Executor runs any number of
+     * stages on the calling thread, switching between them only at co_await
+     * points (a few ns, no kernel involvement). Stages talk through Channels
+     * (an SPSC RingBuffer plus a closed flag) and pull generator output from a
+     * TickSource:
+     *
+     *   co::Task filter(co::Channel<FlatTick>& in, co::Channel<FlatTick>& out) {
+     *       std::array<FlatTick, 256> buf;
+     *       while (std::size_t n = co_await in.pop(buf)) {
+     *           ... co_await out.push(std::span<const FlatTick>(buf.data(), kept));
+     *       }
+     *       out.close();
+     *   }
+     *
+     * Run one Executor per core; a Channel may cross executors (or plain threads),
+     * since it is just an SPSC ring. A stage that cannot proceed is parked and
+     * its condition polled by the executor, so an executor with parked stages
+     * spins (then yields) rather than sleeping.
+     */
+
+    class Executor;
+
+    /// Fire-and-forget stage coroutine. Starts suspended; Executor::spawn()
+    /// takes ownership and destroys the frame when it completes.
+    class Task {
+    public:
+        struct promise_type {
+            Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { error = std::current_exception(); }
+
+            std::exception_ptr error;
+        };
+
+        Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (handle_) handle_.destroy();
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+        ~Task() {
+            if (handle_) handle_.destroy();
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+    private:
+        friend class Executor;
+        explicit Task(std::coroutine_handle<promise_type> h) : handle_(h) {}
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    namespace detail {
+        /// A stage suspended until poll() succeeds (or the executor stops).
+        struct Waiter {
+            std::coroutine_handle<> handle;
+            bool (*poll)(Waiter&) = nullptr;
+        };
+    } // namespace detail
+
+    /// Single-threaded cooperative executor. run() resumes ready stages in FIFO
+    /// order, polls parked ones and fires timers until every spawned stage has
+    /// finished. stop() may be called from any thread: parked and sleeping stages
+    /// are resumed and their awaits report end-of-stream.
+    class Executor {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        Executor() = default;
+
+        ~Executor() {
+            for (auto h : tasks_) h.destroy();
+        }
+
+        Executor(const Executor&) = delete;
+        Executor& operator=(const Executor&) = delete;
+
+        // take ownership of a stage; it first runs inside run()
+        void spawn(Task task) {
+            auto h = std::exchange(task.handle_, {});
+            if (!h) throw std::invalid_argument("Executor: empty task");
+            tasks_.push_back(h);
+            ready_.push_back(h);
+        }
+
+        // run until all stages finish; rethrows the first exception a stage lets escape
+        void run() {
+            Executor* const outer = std::exchange(current_, this);
+            struct Restore {
+                Executor* outer;
+                ~Restore() { current_ = outer; }
+            } restore{outer};
+
+            std::uint32_t idle = 0;
+            while (!tasks_.empty()) {
+                if (stopping()) release_all();
+                fire_timers();
+                poll_parked();
+
+                if (ready_.empty()) {
+                    backoff(idle++);
+                    continue;
+                }
+                idle = 0;
+
+                // only the stages ready now; stages they wake run next round
+                for (std::size_t n = ready_.size(); n != 0; --n) {
+                    const auto h = ready_.front();
+                    ready_.pop_front();
+                    h.resume();
+                    if (h.done()) finish(h);
+                }
+            }
+        }
+
+        void stop() { stop_.store(true, std::memory_order_release); }
+        bool stopping() const { return stop_.load(std::memory_order_acquire); }
+
+        // stages spawned and not yet finished
+        std::size_t tasks() const { return tasks_.size(); }
+
+        // the executor running on this thread, nullptr outside run()
+        static Executor* current() { return current_; }
+
+        static Executor& require() {
+            if (current_ == nullptr) throw std::logic_error("Executor: awaited outside Executor::run()");
+            return *current_;
+        }
+
+        // ---------------- awaiter hooks ----------------
+
+        void schedule(std::coroutine_handle<> h) { ready_.push_back(h); }
+        void park(detail::Waiter& w) { parked_.push_back(&w); }
+        void wake_at(Clock::time_point t, std::coroutine_handle<> h) { timers_.push(Timer{t, timer_seq_++, h}); }
+
+    private:
+        struct Timer {
+            Clock::time_point at;
+            std::uint64_t seq; // FIFO among equal deadlines
+            std::coroutine_handle<> handle;
+            bool operator>(const Timer& o) const { return at != o.at ? at > o.at : seq > o.seq; }
+        };
+
+        void finish(std::coroutine_handle<> h) {
+            auto typed = std::coroutine_handle<Task::promise_type>::from_address(h.address());
+            const std::exception_ptr error = typed.promise().error;
+            tasks_.erase(std::find(tasks_.begin(), tasks_.end(), h));
+            h.destroy();
+            if (error) std::rethrow_exception(error);
+        }
+
+        void fire_timers() {
+            if (timers_.empty()) return;
+            const auto now = Clock::now();
+            while (!timers_.empty() && timers_.top().at <= now) {
+                ready_.push_back(timers_.top().handle);
+                timers_.pop();
+            }
+        }
+
+        void poll_parked() {
+            std::size_t kept = 0;
+            for (detail::Waiter* w : parked_) {
+                if (w->poll(*w)) ready_.push_back(w->handle);
+                else parked_[kept++] = w;
+            }
+            parked_.resize(kept);
+        }
+
+        void release_all() {
+            for (detail::Waiter* w : parked_) ready_.push_back(w->handle);
+            parked_.clear();
+            while (!timers_.empty()) {
+                ready_.push_back(timers_.top().handle);
+                timers_.pop();
+            }
+        }
+
+        // nothing runnable: sleep if only timers are pending, otherwise spin then yield
+        void backoff(std::uint32_t idle) {
+            if (parked_.empty() && !timers_.empty()) {
+                std::this_thread::sleep_until(std::min(timers_.top().at, Clock::now() + std::chrono::milliseconds(1)));
+            } else if (idle < 64) {
+                tickstream::detail::cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        inline static thread_local Executor* current_ = nullptr;
+
+        std::vector<std::coroutine_handle<>> tasks_;
+        std::deque<std::coroutine_handle<>> ready_;
+        std::vector<detail::Waiter*> parked_;
+        std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers_;
+        std::uint64_t timer_seq_{0};
+        std::atomic<bool> stop_{false};
+    };
+
+    /* ---------------- awaitables ---------------- */
+
+    namespace detail {
+        /// Awaiter over a non-blocking attempt: try_once() runs at await_ready and
+        /// on every executor poll until it reports completion.
+        template<typename Derived>
+        struct PollAwaiter : Waiter {
+            bool await_ready() { return static_cast<Derived&>(*this).try_once(); }
+
+            void await_suspend(std::coroutine_handle<> h) {
+                handle = h;
+                poll = [](Waiter& w) { return static_cast<Derived&>(w).try_once(); };
+                Executor::require().park(*this);
+            }
+        };
+
+        template<typename T>
+        struct PopAwaiter : PollAwaiter<PopAwaiter<T>> {
+            PopAwaiter(RingBuffer<T>& ring, std::span<T> out, const std::atomic<bool>* closed)
+                : ring(ring), out(out), closed(closed) {}
+
+            bool try_once() {
+                n = ring.try_pop_n(out);
+                if (n != 0 || out.empty()) return true;
+                if (closed != nullptr && closed->load(std::memory_order_acquire)) {
+                    n = ring.try_pop_n(out); // pushed before the close
+                    return true;
+                }
+                return false;
+            }
+
+            // 0 only once the channel is closed and drained, or the executor stops
+            std::size_t await_resume() {
+                if (n == 0 && !out.empty()) n = ring.try_pop_n(out);
+                return n;
+            }
+
+            RingBuffer<T>& ring;
+            std::span<T> out;
+            const std::atomic<bool>* closed;
+            std::size_t n{0};
+        };
+
+        template<typename T>
+        struct PushAwaiter : PollAwaiter<PushAwaiter<T>> {
+            PushAwaiter(RingBuffer<T>& ring, std::span<const T> items) : ring(ring), items(items) {}
+
+            bool try_once() {
+                pushed += ring.try_push_n(items.subspan(pushed));
+                return pushed == items.size();
+            }
+
+            // items.size(), short only if the executor stopped first
+            std::size_t await_resume() const { return pushed; }
+
+            RingBuffer<T>& ring;
+            std::span<const T> items;
+            std::size_t pushed{0};
+        };
+    } // namespace detail
+
+    // up to out.size() elements, waiting while the ring is empty; 0 if the executor stops
+    template<typename T>
+    detail::PopAwaiter<T> pop(RingBuffer<T>& ring, std::type_identity_t<std::span<T>> out) { return {ring, out, nullptr}; }
+
+    // all of items, waiting while the ring is full; returns how many were pushed
+    template<typename T>
+    detail::PushAwaiter<T> push(RingBuffer<T>& ring, std::type_identity_t<std::span<const T>> items) { return {ring, items}; }
+
+    /// Ring between two stages with end-of-stream: the writer close()s after its
+    /// last push and the reader's pop() returns 0 once everything is drained.
+    /// One writer and one reader, on any executors or threads.
+    template<typename T>
+    class Channel {
+    public:
+        explicit Channel(std::size_t capacity) : ring_(capacity) {}
+
+        Channel(const Channel&) = delete;
+        Channel& operator=(const Channel&) = delete;
+
+        detail::PopAwaiter<T> pop(std::span<T> out) { return {ring_, out, &closed_}; }
+        detail::PushAwaiter<T> push(std::span<const T> items) { return {ring_, items}; }
+
+        void close() { closed_.store(true, std::memory_order_release); }
+        bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+        // the underlying ring, e.g. for a thread-based producer or Consumer
+        RingBuffer<T>& ring() { return ring_; }
+
+    private:
+        RingBuffer<T> ring_;
+        std::atomic<bool> closed_{false};
+    };
+
+    struct SleepAwaiter {
+        Executor::Clock::time_point at;
+
+        bool await_ready() const { return Executor::Clock::now() >= at; }
+        void await_suspend(std::coroutine_handle<> h) const { Executor::require().wake_at(at, h); }
+        void await_resume() const {}
+    };
+
+    inline SleepAwaiter sleep_until(Executor::Clock::time_point t) { return {t}; }
+
+    template<typename Rep, typename Period>
+    SleepAwaiter sleep_for(std::chrono::duration<Rep, Period> d) {
+        return {Executor::Clock::now() + std::chrono::duration_cast<Executor::Clock::duration>(d)};
+    }
+
+    // let the other ready stages run before continuing
+    struct YieldAwaiter {
+        bool await_ready() const { return false; }
+        void await_suspend(std::coroutine_handle<> h) const { Executor::require().schedule(h); }
+        void await_resume() const {}
+    };
+
+    inline YieldAwaiter yield() { return {}; }
+
+    /* ---------------- generator ---------------- */
+
+    /// StreamGen as an awaitable batch source:
+    ///
+    ///   co::TickSource source(gen, 256, true);
+    ///   for (auto batch = co_await source.next(); !batch.empty(); batch = co_await source.next()) ...
+    ///
+    /// Each next() yields up to `batch` ticks (0 => one universe step). A paced
+    /// source releases them on the generator's rate_hz grid (one universe step
+    /// per 1/rate_hz, like StreamGen::run), sleeping on the executor's timers
+    /// in between. The span stays valid until the following next(); it is empty
+    /// after params().max_count ticks (0 => unbounded) or once the executor stops.
+    class TickSource {
+    public:
+        TickSource(StreamGen& gen, std::size_t batch = 0, bool paced = false)
+            : gen_(gen)
+            , buffer_(batch != 0 ? batch : gen.params().symbols.size())
+            , paced_(paced)
+            , remaining_(gen.params().max_count) {}
+
+        struct NextAwaiter {
+            TickSource& source;
+
+            bool await_ready() const { return !source.paced_ || Executor::Clock::now() >= source.deadline_; }
+            void await_suspend(std::coroutine_handle<> h) const { Executor::require().wake_at(source.deadline_, h); }
+            std::span<const FlatTick> await_resume() const { return source.fill(); }
+        };
+
+        NextAwaiter next() {
+            if (paced_ && !started_) {
+                deadline_ = Executor::Clock::now();
+                started_ = true;
+            }
+            return NextAwaiter{*this};
+        }
+
+        std::uint64_t produced() const { return produced_; }
+
+    private:
+        std::span<const FlatTick> fill() {
+            const Executor* ex = Executor::current();
+            if (ex != nullptr && ex->stopping()) return {};
+
+            std::size_t n = buffer_.size();
+            if (gen_.params().max_count != 0) {
+                n = std::min<std::size_t>(n, remaining_);
+                remaining_ -= n;
+            }
+            gen_.next_batch(std::span<FlatTick>(buffer_.data(), n));
+            produced_ += n;
+
+            if (paced_) {
+                const double steps = static_cast<double>(n) / static_cast<double>(gen_.params().symbols.size());
+                deadline_ += std::chrono::duration_cast<Executor::Clock::duration>(
+                    std::chrono::duration<double>(steps / gen_.rate_hz()));
+            }
+            return {buffer_.data(), n};
+        }
+
+        StreamGen& gen_;
+        std::vector<FlatTick> buffer_;
+        bool paced_;
+        bool started_{false};
+        std::size_t remaining_;
+        std::uint64_t produced_{0};
+        Executor::Clock::time_point deadline_{};
+    };
+
+} // namespace tickstream::co
@@ -0,0 +1,19 @@
+// include/tickstream/detail/cache_line.hpp
+
+#pragma once
+
+#include <cstddef>
+
+namespace tickstream::detail {
+
+    // Destructive interference size; hard-coded because
+    // std::hardware_destructive_interference_size is not ABI-stable across compilers.
+    inline constexpr std::size_t cache_line_size = 64;
+
+    /// Wraps a value so that it owns a full cache line (no false sharing with neighbours).
+    template <typename T>
+    struct alignas(cache_line_size) Padded {
+        T value{};
+    };
+
+} // namespace tickstream::detail
@@ -0,0 +1,16 @@
+// include/tickstream/detail/cpu_relax.hpp
+
+#pragma once
+
+namespace tickstream::detail {
+
+    // spin-loop hint: lets the sibling hyper-thread run and avoids memory-order mis-speculation
+    inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
+} // namespace tickstream::detail
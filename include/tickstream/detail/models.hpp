@@ -0,0 +1,25 @@
+// include/tickstream/detail/models.hpp
+
+#pragma once
+
+#include "tickstream/model.hpp"
+
+namespace tickstream::detail {
+
+    /* Structure-of-arrays model engine used by StreamGen, the offline generator
+     * and the book simulator:
+     *   regime:  two-state Markov chain, r in {0,1}
+     *   drift:   X += kappa*(mu - X) dt + sigma_r sqrt(dt) Z + J
+     *   jumps:   J = N*jump_mean + sqrt(N)*jump_std*Zj,  N ~ Poisson(lambda_jump dt)
+     *   shocks:  Z independent, or correlated across symbols by a factor model or
+     *            a Cholesky-factorized correlation matrix (Params::factor_loadings,
+     *            Params::correlation)
+     *   quote:   P = round((X + sigma_micro Zm) / tick_size) * tick_size
+     *
+     * Kernels are flat loops over contiguous doubles with no calls or data-dependent
+     * branches so the compiler can vectorize them for whatever ISA the build targets.
+     * See model.hpp for other compositions.
+     */
+    using MultiSymbolEngine = DefaultModel;
+
+} // namespace tickstream::detail
@@ -4,19 +4,237 @@
 #define TICKSTREAM_RNG_H
 
 #pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <numbers>
 #include <random>
+#include <span>
 
 namespace tickstream::detail {
+
+    /// Philox4x32-10 counter-based bit generator (Salmon et al., "Parallel random numbers:
+    /// as easy as 1, 2, 3"). Output block = bijection(counter, key), so any draw can be
+    /// computed directly from its counter without replaying the stream.
+    class Philox4x32 {
+    public:
+        using result_type = std::uint32_t;
+        using counter_type = std::array<std::uint32_t, 4>;
+        using key_type = std::array<std::uint32_t, 2>;
+
+        static constexpr std::uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+        static constexpr std::uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+        static constexpr int rounds = 10;
+
+        static constexpr counter_type block(counter_type c, key_type k) {
+            for (int r = 0; r < rounds; ++r) {
+                const std::uint64_t p0 = std::uint64_t{M0} * c[0];
+                const std::uint64_t p1 = std::uint64_t{M1} * c[2];
+                c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<std::uint32_t>(p1),
+                     static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<std::uint32_t>(p0)};
+                k[0] += W0;
+                k[1] += W1;
+            }
+            return c;
+        }
+
+        // lanes[j][i] = block(counter_i, key)[j] with counter_i = base + i on word `axis`
+        // (axis 0 steps the position, axis 2 steps the stream); laid out for vectorization.
+        static void blocks(counter_type base, key_type key, int axis, std::size_t n,
+                           std::uint32_t* out0, std::uint32_t* out1, std::uint32_t* out2, std::uint32_t* out3) {
+            const std::uint64_t start = std::uint64_t{base[axis]} | (std::uint64_t{base[axis + 1]} << 32);
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::uint64_t v = start + i;
+                out0[i] = base[0]; out1[i] = base[1]; out2[i] = base[2]; out3[i] = base[3];
+                (axis == 0 ? out0 : out2)[i] = static_cast<std::uint32_t>(v);
+                (axis == 0 ? out1 : out3)[i] = static_cast<std::uint32_t>(v >> 32);
+            }
+            std::uint32_t k0 = key[0], k1 = key[1];
+            for (int r = 0; r < rounds; ++r) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    const std::uint64_t p0 = std::uint64_t{M0} * out0[i];
+                    const std::uint64_t p1 = std::uint64_t{M1} * out2[i];
+                    const std::uint32_t c1 = out1[i], c3 = out3[i];
+                    out0[i] = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                    out1[i] = static_cast<std::uint32_t>(p1);
+                    out2[i] = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                    out3[i] = static_cast<std::uint32_t>(p0);
+                }
+                k0 += W0;
+                k1 += W1;
+            }
+        }
+
+        Philox4x32(key_type key, counter_type counter) : key_(key), ctr_(counter) {}
+
+        // UniformRandomBitGenerator: walks the counter's low 64 bits, four words per block
+        result_type operator()() {
+            if (idx_ == 4) {
+                buf_ = block(ctr_, key_);
+                if (++ctr_[0] == 0) ++ctr_[1];
+                idx_ = 0;
+            }
+            return buf_[idx_++];
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    private:
+        key_type key_;
+        counter_type ctr_;
+        counter_type buf_{};
+        int idx_{4};
+    };
+
+    /// Counter-based RNG stream.
+    ///
+    /// A draw is addressed by (seed, stream, position): the key comes from the seed,
+    /// the 128-bit counter is {position, stream}, and every draw of any kind consumes
+    /// exactly one Philox block. Output is therefore bit-identical no matter how draws
+    /// are batched, and substreams are free (a different stream word, same key).
     class RNG {
     public:
-        explicit RNG(std::uint64_t seed);
-        double normal(double mean, double stddev);
-        double uniform(double a, double b);
-        int poisson(double lambda_dt);
-        std::mt19937_64 &engine(); // for advanced use
+        explicit RNG(std::uint64_t seed, std::uint64_t stream = 0)
+            : key_(make_key(seed)), stream_(stream) {}
+
+        // independent stream under the same seed (per-symbol, per-thread, ...)
+        RNG substream(std::uint64_t stream) const {
+            RNG r(*this);
+            r.stream_ = stream;
+            r.pos_ = 0;
+            return r;
+        }
+
+        double normal(double mean, double stddev) {
+            return mean + stddev * to_normal(next_block());
+        }
+
+        double uniform(double a, double b) {
+            return a + (b - a) * to_unit(next_block());
+        }
+
+        // inversion for small means (one block per draw); normal approximation above 30
+        int poisson(double lambda_dt) {
+            return to_poisson(next_block(), lambda_dt);
+        }
+
+        // bulk draws along this stream; equivalent to calling the scalar draw out.size() times
+        void fill_uniform(std::span<double> out, double a = 0.0, double b = 1.0) {
+            generate(out, axis_position, pos_, stream_, [&](const Philox4x32::counter_type& c) {
+                return a + (b - a) * to_unit(c);
+            });
+            pos_ += out.size();
+        }
+
+        void fill_normal(std::span<double> out, double mean = 0.0, double stddev = 1.0) {
+            generate(out, axis_position, pos_, stream_, [&](const Philox4x32::counter_type& c) {
+                return mean + stddev * to_normal(c);
+            });
+            pos_ += out.size();
+        }
+
+        void fill_poisson(std::span<int> out, double lambda_dt) {
+            generate(out, axis_position, pos_, stream_, [&](const Philox4x32::counter_type& c) {
+                return to_poisson(c, lambda_dt);
+            });
+            pos_ += out.size();
+        }
+
+        // bulk draws across streams: out[i] is draw `position` of stream first_stream + i.
+        // Stateless, so shards of a universe can be filled independently.
+        void uniform_lanes(std::span<double> out, std::uint64_t first_stream, std::uint64_t position,
+                           double a = 0.0, double b = 1.0) const {
+            generate(out, axis_stream, position, first_stream, [&](const Philox4x32::counter_type& c) {
+                return a + (b - a) * to_unit(c);
+            });
+        }
+
+        void normal_lanes(std::span<double> out, std::uint64_t first_stream, std::uint64_t position,
+                          double mean = 0.0, double stddev = 1.0) const {
+            generate(out, axis_stream, position, first_stream, [&](const Philox4x32::counter_type& c) {
+                return mean + stddev * to_normal(c);
+            });
+        }
+
+        std::uint64_t stream() const { return stream_; }
+        std::uint64_t position() const { return pos_; }
+        void seek(std::uint64_t position) { pos_ = position; }
+
+        Philox4x32 engine() const { return Philox4x32(key_, counter(pos_, stream_)); } // for std:: distributions
+
     private:
-        std::mt19937_64 eng_;
+        static constexpr int axis_position = 0;
+        static constexpr int axis_stream = 2;
+        static constexpr std::size_t chunk = 64;
+
+        static Philox4x32::key_type make_key(std::uint64_t seed) {
+            if (seed == 0) seed = (std::uint64_t{std::random_device{}()} << 32) ^ std::random_device{}();
+            // splitmix64 finalizer so nearby seeds give unrelated keys
+            std::uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+            return {static_cast<std::uint32_t>(z), static_cast<std::uint32_t>(z >> 32)};
+        }
+
+        static Philox4x32::counter_type counter(std::uint64_t pos, std::uint64_t stream) {
+            return {static_cast<std::uint32_t>(pos), static_cast<std::uint32_t>(pos >> 32),
+                    static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)};
+        }
+
+        // [0,1) with 53 bits from words 0-1
+        static double to_unit(const Philox4x32::counter_type& c) {
+            const std::uint64_t bits = (std::uint64_t{c[1]} << 32) | c[0];
+            return static_cast<double>(bits >> 11) * 0x1.0p-53;
+        }
+
+        // Box-Muller (cosine branch): u1 in (0,1] from words 0-1, u2 in [0,1) from words 2-3
+        static double to_normal(const Philox4x32::counter_type& c) {
+            const std::uint64_t b1 = (std::uint64_t{c[1]} << 32) | c[0];
+            const std::uint64_t b2 = (std::uint64_t{c[3]} << 32) | c[2];
+            const double u1 = static_cast<double>((b1 >> 11) + 1) * 0x1.0p-53;
+            const double u2 = static_cast<double>(b2 >> 11) * 0x1.0p-53;
+            return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+        }
+
+        static int to_poisson(const Philox4x32::counter_type& c, double lambda) {
+            if (lambda <= 0.0) return 0;
+            if (lambda >= 30.0) {
+                return static_cast<int>(std::max(0.0, std::floor(lambda + std::sqrt(lambda) * to_normal(c) + 0.5)));
+            }
+            const double u = to_unit(c);
+            double p = std::exp(-lambda), cdf = p;
+            int k = 0;
+            while (u >= cdf && k < 200) {
+                ++k;
+                p *= lambda / k;
+                cdf += p;
+            }
+            return k;
+        }
+
+        template <typename Out, typename Transform>
+        void generate(std::span<Out> out, int axis, std::uint64_t pos, std::uint64_t stream, Transform&& f) const {
+            alignas(64) std::uint32_t w0[chunk], w1[chunk], w2[chunk], w3[chunk];
+            for (std::size_t done = 0; done < out.size(); done += chunk) {
+                const std::size_t n = std::min(chunk, out.size() - done);
+                const auto base = axis == axis_position ? counter(pos + done, stream) : counter(pos, stream + done);
+                Philox4x32::blocks(base, key_, axis, n, w0, w1, w2, w3);
+                for (std::size_t i = 0; i < n; ++i) out[done + i] = f({w0[i], w1[i], w2[i], w3[i]});
+            }
+        }
+
+        Philox4x32::counter_type next_block() {
+            return Philox4x32::block(counter(pos_++, stream_), key_);
+        }
+
+        Philox4x32::key_type key_;
+        std::uint64_t stream_;
+        std::uint64_t pos_{0};
     };
 } // namespace tickstream::detail
 
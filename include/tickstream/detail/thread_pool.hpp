@@ -0,0 +1,162 @@
+// include/tickstream/detail/thread_pool.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tickstream::detail {
+
+    /// Small work-stealing pool for batch jobs.
+    ///
+    /// Each worker owns a deque: it pops its own tasks from the front and steals
+    /// from the back of the others when idle. submit() spreads a batch round-robin
+    /// over the deques; wait() lets the calling thread execute queued tasks until
+    /// the batch has finished. A task that throws does not take down its worker:
+    /// the first exception of a batch is kept and rethrown by wait() once every
+    /// task of that batch has run.
+    class WorkStealingPool {
+    public:
+        class Batch {
+        public:
+            bool done() const { return remaining_.load(std::memory_order_acquire) == 0; }
+
+        private:
+            friend class WorkStealingPool;
+            std::atomic<std::size_t> remaining_{0};
+            std::mutex error_mutex_;
+            std::exception_ptr error_; // first failure, guarded by error_mutex_
+        };
+
+        explicit WorkStealingPool(std::size_t threads = 0) {
+            if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+            for (std::size_t i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+            for (std::size_t i = 0; i < threads; ++i) workers_.emplace_back([this, i] { work(i); });
+        }
+
+        ~WorkStealingPool() {
+            {
+                std::lock_guard lock(idle_mutex_);
+                stopping_ = true;
+            }
+            idle_cv_.notify_all();
+            for (auto& t : workers_) t.join();
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        std::size_t size() const { return workers_.size(); }
+
+        // run f(i) for i in [0, n) asynchronously
+        std::shared_ptr<Batch> submit(std::size_t n, std::function<void(std::size_t)> f) {
+            auto batch = std::make_shared<Batch>();
+            batch->remaining_.store(n, std::memory_order_relaxed);
+            auto shared = std::make_shared<std::function<void(std::size_t)>>(std::move(f));
+            {
+                std::lock_guard lock(idle_mutex_);
+                pending_ += n;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                Queue& q = *queues_[(next_queue_++) % queues_.size()];
+                std::lock_guard lock(q.mutex);
+                q.tasks.push_back([batch, shared, i] {
+                    try {
+                        (*shared)(i);
+                    } catch (...) {
+                        std::lock_guard error_lock(batch->error_mutex_);
+                        if (!batch->error_) batch->error_ = std::current_exception();
+                    }
+                    batch->remaining_.fetch_sub(1, std::memory_order_acq_rel);
+                });
+            }
+            idle_cv_.notify_all();
+            return batch;
+        }
+
+        // block until the batch is done, running queued tasks meanwhile; rethrows
+        // the first exception a task of the batch raised
+        void wait(Batch& batch) {
+            while (!batch.done()) {
+                if (!run_one(0)) std::this_thread::yield();
+            }
+            std::exception_ptr error;
+            {
+                std::lock_guard lock(batch.error_mutex_);
+                error = batch.error_;
+            }
+            if (error) std::rethrow_exception(error);
+        }
+
+        void run(std::size_t n, std::function<void(std::size_t)> f) {
+            wait(*submit(n, std::move(f)));
+        }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        bool take(std::size_t self, std::function<void()>& task) {
+            {
+                Queue& own = *queues_[self];
+                std::lock_guard lock(own.mutex);
+                if (!own.tasks.empty()) {
+                    task = std::move(own.tasks.front());
+                    own.tasks.pop_front();
+                    return true;
+                }
+            }
+            for (std::size_t k = 1; k < queues_.size(); ++k) {
+                Queue& victim = *queues_[(self + k) % queues_.size()];
+                std::lock_guard lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.back());
+                    victim.tasks.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool run_one(std::size_t self) {
+            std::function<void()> task;
+            if (!take(self, task)) return false;
+            {
+                std::lock_guard lock(idle_mutex_);
+                --pending_;
+            }
+            task();
+            return true;
+        }
+
+        void work(std::size_t self) {
+            for (;;) {
+                if (run_one(self)) continue;
+                std::unique_lock lock(idle_mutex_);
+                idle_cv_.wait(lock, [&] { return stopping_ || pending_ != 0; });
+                if (stopping_ && pending_ == 0) return;
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> workers_;
+        std::atomic<std::size_t> next_queue_{0};
+
+        std::mutex idle_mutex_;
+        std::condition_variable idle_cv_;
+        std::size_t pending_{0}; // queued, not yet taken
+        bool stopping_{false};
+    };
+
+} // namespace tickstream::detail
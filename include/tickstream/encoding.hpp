@@ -0,0 +1,384 @@
+// include/tickstream/encoding.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "symbols.hpp"
+#include "tick.hpp"
+
+namespace tickstream {
+
+    enum class Format {
+        Csv,       // header line, then symbol,price,volume,bid,ask,unix_ts_ns,mono_ts_ns,sequence
+        JsonLines, // one object per line with the same fields
+        Binary     // framed records, see encoding::FrameHeader
+    };
+
+    // "csv", "jsonl" (or "json"), "binary" (or "bin")
+    inline Format parse_format(std::string_view name) {
+        if (name == "csv") return Format::Csv;
+        if (name == "jsonl" || name == "json") return Format::JsonLines;
+        if (name == "binary" || name == "bin") return Format::Binary;
+        throw std::invalid_argument("parse_format: unknown format " + std::string(name));
+    }
+
+    /* Binary stream (native endianness):
+     *
+     *   magic "TSB1", u32 version
+     *   frames: FrameHeader { u8 kind, u8 reserved, u16 payload bytes }, payload
+     *     Symbol: u32 stream-local id, name bytes (precedes the first tick using the id)
+     *     Tick:   TickRecord
+     *
+     * Only top of book is encoded, as in recordings; depth travels as book deltas.
+     */
+    namespace encoding {
+
+        inline constexpr char magic[4] = {'T', 'S', 'B', '1'};
+        inline constexpr std::uint32_t version = 1;
+
+        enum class FrameKind : std::uint8_t { Symbol = 1, Tick = 2 };
+
+        struct FrameHeader {
+            std::uint8_t kind;
+            std::uint8_t reserved;
+            std::uint16_t bytes; // payload size
+        };
+        static_assert(sizeof(FrameHeader) == 4);
+
+        struct TickRecord {
+            double price;
+            double volume;
+            double bid;
+            double ask;
+            std::uint64_t unix_ts_ns;
+            std::uint64_t mono_ts_ns;
+            std::uint32_t symbol;   // stream-local id
+            std::uint32_t sequence;
+        };
+        static_assert(sizeof(TickRecord) == 56);
+
+        inline constexpr std::string_view csv_header = "symbol,price,volume,bid,ask,unix_ts_ns,mono_ts_ns,sequence\n";
+
+        // upper bound of one encoded tick excluding its cached symbol prefix
+        inline constexpr std::size_t max_record = 256;
+
+        inline char* put(char* p, std::string_view s) {
+            std::memcpy(p, s.data(), s.size());
+            return p + s.size();
+        }
+
+        // shortest representation that round-trips
+        inline char* put(char* p, double v) { return std::to_chars(p, p + 32, v).ptr; }
+        inline char* put(char* p, std::uint64_t v) { return std::to_chars(p, p + 20, v).ptr; }
+
+        // JSON has no inf/nan
+        inline char* put_json(char* p, double v) { return std::isfinite(v) ? put(p, v) : put(p, std::string_view("null")); }
+
+        inline std::string json_escape(std::string_view s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                    out += c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    constexpr char hex[] = "0123456789abcdef";
+                    out += "\\u00";
+                    out += hex[(c >> 4) & 0xf];
+                    out += hex[c & 0xf];
+                } else {
+                    out += c;
+                }
+            }
+            return out;
+        }
+
+        inline std::string csv_escape(std::string_view s) {
+            if (s.find_first_of(",\"\r\n") == std::string_view::npos) return std::string(s);
+            std::string out = "\"";
+            for (char c : s) {
+                if (c == '"') out += '"';
+                out += c;
+            }
+            return out + '"';
+        }
+
+    } // namespace encoding
+
+    /// Streams FlatTicks to a file descriptor as CSV, JSON lines or binary frames.
+    ///
+    /// Numbers are formatted with std::to_chars into one large buffer that is
+    /// handed to write(2) whole; the per-symbol part of each record (quoted name,
+    /// JSON key) is built once per symbol. Usable directly as a Consumer handler:
+    /// consumer.subscribe(std::ref(writer)).
+    class TickWriter {
+    public:
+        // does not take ownership of fd
+        TickWriter(int fd, Format format, std::size_t buffer_bytes = 1 << 20,
+                   const SymbolRegistry& registry = SymbolRegistry::global())
+            : registry_(registry), fd_(fd), format_(format)
+            , buffer_(std::max<std::size_t>(buffer_bytes, 4 * encoding::max_record)) {
+            preamble();
+        }
+
+        TickWriter(const std::string& path, Format format, std::size_t buffer_bytes = 1 << 20,
+                   const SymbolRegistry& registry = SymbolRegistry::global())
+            : registry_(registry), format_(format)
+            , buffer_(std::max<std::size_t>(buffer_bytes, 4 * encoding::max_record)) {
+            fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd_ < 0) throw std::runtime_error("TickWriter: cannot open " + path);
+            owns_fd_ = true;
+            preamble();
+        }
+
+        ~TickWriter() {
+            try { close(); } catch (...) {}
+        }
+
+        TickWriter(const TickWriter&) = delete;
+        TickWriter& operator=(const TickWriter&) = delete;
+
+        void write(std::span<const FlatTick> ticks) {
+            switch (format_) {
+            case Format::Csv: encode<Format::Csv>(ticks); break;
+            case Format::JsonLines: encode<Format::JsonLines>(ticks); break;
+            case Format::Binary: encode<Format::Binary>(ticks); break;
+            }
+        }
+
+        void write(const FlatTick& t) { write(std::span<const FlatTick>(&t, 1)); }
+        void operator()(const FlatTick& t) { write(t); }
+
+        // hand everything buffered to the kernel; throws std::system_error (e.g. EPIPE)
+        void flush() {
+            std::size_t done = 0;
+            while (done < used_) {
+                const ssize_t n = ::write(fd_, buffer_.data() + done, used_ - done);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    const int error = errno;
+                    used_ = 0;
+                    throw std::system_error(error, std::generic_category(), "TickWriter: write failed");
+                }
+                done += static_cast<std::size_t>(n);
+            }
+            bytes_ += used_;
+            used_ = 0;
+        }
+
+        // flush and release the descriptor if owned; idempotent
+        void close() {
+            if (fd_ < 0) return;
+            try {
+                flush();
+            } catch (...) {
+                release();
+                throw;
+            }
+            release();
+        }
+
+        Format format() const { return format_; }
+        std::uint64_t ticks() const { return ticks_; }
+        std::uint64_t bytes() const { return bytes_ + used_; } // written plus buffered
+
+    private:
+        void release() {
+            if (owns_fd_) ::close(fd_);
+            fd_ = -1;
+        }
+
+        void preamble() {
+            char* p = buffer_.data();
+            if (format_ == Format::Csv) p = encoding::put(p, encoding::csv_header);
+            if (format_ == Format::Binary) {
+                p = encoding::put(p, std::string_view(encoding::magic, sizeof(encoding::magic)));
+                std::memcpy(p, &encoding::version, sizeof(encoding::version));
+                p += sizeof(encoding::version);
+            }
+            used_ = static_cast<std::size_t>(p - buffer_.data());
+        }
+
+        template<Format F>
+        void encode(std::span<const FlatTick> ticks) {
+            for (const FlatTick& t : ticks) {
+                const std::string& prefix = prefix_for(t.symbol_id);
+                if (used_ + prefix.size() + encoding::max_record > buffer_.size()) {
+                    flush();
+                    if (prefix.size() + encoding::max_record > buffer_.size()) buffer_.resize(prefix.size() + encoding::max_record);
+                }
+                char* p = buffer_.data() + used_;
+                using encoding::put;
+
+                if constexpr (F == Format::Csv) {
+                    p = put(p, prefix);
+                    p = put(p, t.price);     *p++ = ',';
+                    p = put(p, t.volume);    *p++ = ',';
+                    p = put(p, t.bid);       *p++ = ',';
+                    p = put(p, t.ask);       *p++ = ',';
+                    p = put(p, t.unix_ts_ns); *p++ = ',';
+                    p = put(p, t.mono_ts_ns); *p++ = ',';
+                    p = put(p, std::uint64_t{t.sequence});
+                    *p++ = '\n';
+                } else if constexpr (F == Format::JsonLines) {
+                    using encoding::put_json;
+                    p = put(p, prefix); // {"symbol":"...","price":
+                    p = put_json(p, t.price);
+                    p = put(p, std::string_view(",\"volume\":"));
+                    p = put_json(p, t.volume);
+                    p = put(p, std::string_view(",\"bid\":"));
+                    p = put_json(p, t.bid);
+                    p = put(p, std::string_view(",\"ask\":"));
+                    p = put_json(p, t.ask);
+                    p = put(p, std::string_view(",\"unix_ts_ns\":"));
+                    p = put(p, t.unix_ts_ns);
+                    p = put(p, std::string_view(",\"mono_ts_ns\":"));
+                    p = put(p, t.mono_ts_ns);
+                    p = put(p, std::string_view(",\"sequence\":"));
+                    p = put(p, std::uint64_t{t.sequence});
+                    p = put(p, std::string_view("}\n"));
+                } else {
+                    // a pending Symbol frame sits in prefix until the symbol's first tick
+                    p = put(p, prefix);
+                    if (!prefix.empty()) prefix_[t.symbol_id].clear();
+                    const encoding::FrameHeader h{static_cast<std::uint8_t>(encoding::FrameKind::Tick), 0,
+                                                  sizeof(encoding::TickRecord)};
+                    const encoding::TickRecord r{t.price, t.volume, t.bid, t.ask, t.unix_ts_ns, t.mono_ts_ns,
+                                                 t.symbol_id, t.sequence};
+                    std::memcpy(p, &h, sizeof(h));
+                    std::memcpy(p + sizeof(h), &r, sizeof(r));
+                    p += sizeof(h) + sizeof(r);
+                }
+
+                used_ = static_cast<std::size_t>(p - buffer_.data());
+            }
+            ticks_ += ticks.size();
+        }
+
+        // per-symbol record prefix, built on first use
+        const std::string& prefix_for(SymbolId id) {
+            if (id >= known_.size()) {
+                known_.resize(id + 1, false);
+                prefix_.resize(id + 1);
+            }
+            if (known_[id]) return prefix_[id];
+            known_[id] = true;
+
+            const std::string_view name = registry_.name(id);
+            std::string& s = prefix_[id];
+            switch (format_) {
+            case Format::Csv:
+                s = encoding::csv_escape(name) + ',';
+                break;
+            case Format::JsonLines:
+                s = "{\"symbol\":\"" + encoding::json_escape(name) + "\",\"price\":";
+                break;
+            case Format::Binary: {
+                const std::size_t len = std::min<std::size_t>(name.size(), 0xffff - sizeof(std::uint32_t));
+                const encoding::FrameHeader h{static_cast<std::uint8_t>(encoding::FrameKind::Symbol), 0,
+                                              static_cast<std::uint16_t>(sizeof(std::uint32_t) + len)};
+                const std::uint32_t local = id;
+                s.assign(reinterpret_cast<const char*>(&h), sizeof(h));
+                s.append(reinterpret_cast<const char*>(&local), sizeof(local));
+                s.append(name.data(), len);
+                break;
+            }
+            }
+            return s;
+        }
+
+        const SymbolRegistry& registry_;
+        int fd_{-1};
+        bool owns_fd_{false};
+        Format format_;
+        std::vector<char> buffer_;
+        std::size_t used_{0};
+        std::uint64_t ticks_{0};
+        std::uint64_t bytes_{0};
+        std::vector<bool> known_;
+        std::vector<std::string> prefix_;
+    };
+
+    /// Incremental decoder for the binary stream: feed it arbitrary chunks and it
+    /// calls f(const FlatTick&) for every complete tick frame, interning symbol
+    /// names into `registry`.
+    class BinaryDecoder {
+    public:
+        explicit BinaryDecoder(SymbolRegistry& registry = SymbolRegistry::global()) : registry_(registry) {}
+
+        // returns the number of bytes consumed; pass the rest again with more data
+        template<typename F>
+        std::size_t decode(std::span<const char> data, F&& f) {
+            std::size_t pos = 0;
+            if (!started_) {
+                constexpr std::size_t preamble = sizeof(encoding::magic) + sizeof(encoding::version);
+                if (data.size() < preamble) return 0;
+                if (std::memcmp(data.data(), encoding::magic, sizeof(encoding::magic)) != 0) {
+                    throw std::runtime_error("BinaryDecoder: bad magic");
+                }
+                std::uint32_t v;
+                std::memcpy(&v, data.data() + sizeof(encoding::magic), sizeof(v));
+                if (v != encoding::version) throw std::runtime_error("BinaryDecoder: unsupported version");
+                started_ = true;
+                pos = preamble;
+            }
+
+            while (pos + sizeof(encoding::FrameHeader) <= data.size()) {
+                encoding::FrameHeader h;
+                std::memcpy(&h, data.data() + pos, sizeof(h));
+                if (pos + sizeof(h) + h.bytes > data.size()) break;
+                const char* payload = data.data() + pos + sizeof(h);
+
+                if (h.kind == static_cast<std::uint8_t>(encoding::FrameKind::Symbol)) {
+                    if (h.bytes < sizeof(std::uint32_t)) throw std::runtime_error("BinaryDecoder: corrupt symbol frame");
+                    std::uint32_t local;
+                    std::memcpy(&local, payload, sizeof(local));
+                    if (local >= ids_.size()) ids_.resize(local + 1, unmapped);
+                    ids_[local] = registry_.intern(std::string_view(payload + sizeof(local), h.bytes - sizeof(local)));
+                } else if (h.kind == static_cast<std::uint8_t>(encoding::FrameKind::Tick)) {
+                    if (h.bytes != sizeof(encoding::TickRecord)) throw std::runtime_error("BinaryDecoder: corrupt tick frame");
+                    encoding::TickRecord r;
+                    std::memcpy(&r, payload, sizeof(r));
+                    if (r.symbol >= ids_.size() || ids_[r.symbol] == unmapped) {
+                        throw std::runtime_error("BinaryDecoder: tick before its symbol");
+                    }
+                    FlatTick t{};
+                    t.price = r.price;
+                    t.volume = r.volume;
+                    t.bid = r.bid;
+                    t.ask = r.ask;
+                    t.unix_ts_ns = r.unix_ts_ns;
+                    t.mono_ts_ns = r.mono_ts_ns;
+                    t.symbol_id = ids_[r.symbol];
+                    t.sequence = r.sequence;
+                    f(static_cast<const FlatTick&>(t));
+                }
+                // unknown kinds are skipped: later versions may add frames
+                pos += sizeof(h) + h.bytes;
+            }
+            return pos;
+        }
+
+    private:
+        static constexpr SymbolId unmapped = ~SymbolId{0};
+
+        SymbolRegistry& registry_;
+        bool started_{false};
+        std::vector<SymbolId> ids_; // stream-local id -> registry id
+    };
+
+} // namespace tickstream
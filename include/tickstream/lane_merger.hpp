@@ -0,0 +1,150 @@
+// include/tickstream/lane_merger.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ring_buffer.hpp"
+#include "stats.hpp"
+
+namespace tickstream {
+
+    /// Timestamp-ordered fan-in over per-producer SPSC lanes.
+    ///
+    /// Each lane's head is staged in the merger (popped once, so overwritable lanes
+    /// work too) and a binary heap over the staged heads yields the earliest
+    /// mono_ts_ns, ties broken by lane index. While some lane is empty its next tick
+    /// could still be earlier than every staged head, so the minimum is held back
+    /// until it is reorder_window old; a window of zero (the default) emits the
+    /// earliest available tick immediately, so the output is only best-effort
+    /// ordered. Ticks that arrive later than the window and sort before something
+    /// already emitted are passed through and counted in late().
+    ///
+    /// Single consumer: all calls except the lane producers' pushes come from one thread.
+    template<typename T>
+    class LaneMerger {
+    public:
+        explicit LaneMerger(std::chrono::nanoseconds reorder_window = std::chrono::nanoseconds::zero())
+            : window_ns_(static_cast<std::uint64_t>(std::max<std::int64_t>(reorder_window.count(), 0))) {}
+
+        LaneMerger(const LaneMerger&) = delete;
+        LaneMerger& operator=(const LaneMerger&) = delete;
+
+        // the ring must outlive the merger; returns the lane index (used for tie-breaks)
+        std::size_t add_lane(RingBuffer<T>& ring) {
+            lanes_.push_back(Lane{&ring, T{}});
+            idle_.push_back(lanes_.size() - 1);
+            heap_.reserve(lanes_.size());
+            return lanes_.size() - 1;
+        }
+
+        void set_reorder_window(std::chrono::nanoseconds window) {
+            window_ns_ = static_cast<std::uint64_t>(std::max<std::int64_t>(window.count(), 0));
+        }
+
+        std::chrono::nanoseconds reorder_window() const { return std::chrono::nanoseconds(window_ns_); }
+        std::size_t lanes() const { return lanes_.size(); }
+
+        // hands f(const T&) every tick releasable at now_ns, in order; returns the count
+        template<typename F>
+        std::size_t poll(F&& f, std::uint64_t now_ns = StreamStats::now_ns(),
+                         std::size_t max_items = std::numeric_limits<std::size_t>::max()) {
+            return merge(f, now_ns, max_items, false);
+        }
+
+        // emits everything currently queued regardless of the window (e.g. after stop())
+        template<typename F>
+        std::size_t flush(F&& f) {
+            return merge(f, 0, std::numeric_limits<std::size_t>::max(), true);
+        }
+
+        // when poll() would release the earliest staged tick that the window holds
+        // back; max() when nothing is staged
+        std::uint64_t release_at_ns() const {
+            if (heap_.empty()) return std::numeric_limits<std::uint64_t>::max();
+            return lanes_[heap_.front()].head.mono_ts_ns + window_ns_;
+        }
+
+        // queued in the lanes plus staged here
+        std::size_t size() const {
+            std::size_t n = heap_.size();
+            for (const auto& lane : lanes_) n += lane.ring->size();
+            return n;
+        }
+
+        bool empty() const { return size() == 0; }
+
+        // ticks emitted out of order because they arrived after the reorder window
+        std::uint64_t late() const { return late_; }
+
+    private:
+        struct Lane {
+            RingBuffer<T>* ring;
+            T head;
+        };
+
+        bool later(std::size_t a, std::size_t b) const {
+            const auto ta = lanes_[a].head.mono_ts_ns, tb = lanes_[b].head.mono_ts_ns;
+            return ta != tb ? ta > tb : a > b;
+        }
+
+        // stage the head of every lane that has data again
+        void refill() {
+            const auto cmp = [this](std::size_t a, std::size_t b) { return later(a, b); };
+            for (std::size_t k = 0; k < idle_.size();) {
+                const std::size_t i = idle_[k];
+                if (lanes_[i].ring->try_pop(lanes_[i].head)) {
+                    heap_.push_back(i);
+                    std::push_heap(heap_.begin(), heap_.end(), cmp);
+                    idle_[k] = idle_.back();
+                    idle_.pop_back();
+                } else {
+                    ++k;
+                }
+            }
+        }
+
+        template<typename F>
+        std::size_t merge(F& f, std::uint64_t now_ns, std::size_t max_items, bool force) {
+            const auto cmp = [this](std::size_t a, std::size_t b) { return later(a, b); };
+            std::size_t n = 0;
+            while (n < max_items) {
+                if (!idle_.empty()) refill();
+                if (heap_.empty()) break;
+
+                const std::size_t i = heap_.front();
+                const std::uint64_t ts = lanes_[i].head.mono_ts_ns;
+                // an empty lane may still deliver something earlier: hold back inside the window
+                if (!force && window_ns_ != 0 && !idle_.empty() && now_ns < ts + window_ns_) break;
+
+                std::pop_heap(heap_.begin(), heap_.end(), cmp);
+                heap_.pop_back();
+                if (ts < last_ts_) ++late_;
+                last_ts_ = std::max(last_ts_, ts);
+                f(static_cast<const T&>(lanes_[i].head));
+                ++n;
+
+                if (lanes_[i].ring->try_pop(lanes_[i].head)) {
+                    heap_.push_back(i);
+                    std::push_heap(heap_.begin(), heap_.end(), cmp);
+                } else {
+                    idle_.push_back(i);
+                }
+            }
+            return n;
+        }
+
+        std::vector<Lane> lanes_;
+        std::vector<std::size_t> heap_; // lanes with a staged head, earliest first
+        std::vector<std::size_t> idle_; // lanes with nothing staged
+        std::uint64_t window_ns_;
+        std::uint64_t last_ts_{0};
+        std::uint64_t late_{0};
+    };
+
+} // namespace tickstream
@@ -0,0 +1,658 @@
+// include/tickstream/model.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "tickstream/params.hpp"
+#include "tickstream/detail/rng.h"
+
+namespace tickstream {
+
+    /* Price models composed from compile-time policies.
+     *
+     *   Model<OU, RegimeSwitch<2>, Jumps, Microstructure>   (the default model)
+     *   Model<GBM>                                          (plain lognormal, constant vol)
+     *   Model<OU, RegimeSwitch<3>>                          (three-state volatility, no jumps)
+     *
+     * A model has one component per role, in any order: a drift (OU or GBM,
+     * required), a volatility (ConstantVol by default, or RegimeSwitch<N>), jumps
+     * (none by default), microstructure (none by default: price = level, off
+     * the grid) and cross-sectional correlation of the drift shocks (independent
+     * by default). Omitted roles cost nothing: their state, draws and kernel terms
+     * are removed at compile time.
+     *
+     * Every step advances all symbols at once with SoA kernels. Draw k of symbol i
+     * at step t is RNG position t*draws_per_step + k on stream first_stream + i,
+     * and each role owns fixed k's, so adding or removing a component never shifts
+     * another component's draws:
+     *   0 drift shock   1 regime   2 jump count   3 jump size   4 micro noise   5 volume */
+
+    namespace model {
+        struct drift_role {};
+        struct volatility_role {};
+        struct jump_role {};
+        struct micro_role {};
+        struct shock_role {};
+    } // namespace model
+
+    /* ---------------- drift ---------------- */
+
+    /// dX = kappa*(mu - X) dt + sigma dW + J
+    class OU {
+    public:
+        using role = model::drift_role;
+
+        static double initial(const Params& p) { return p.mu; }
+
+        void configure(const Params& p, double dt) {
+            kdt_ = p.kappa * dt;
+            mu_ = p.mu;
+        }
+
+        void resize(std::size_t n) { z_.resize(n); }
+
+        void draw(const detail::RNG& rng, std::uint64_t first_stream, std::uint64_t base) {
+            rng.normal_lanes(z_, first_stream, base + 0);
+        }
+
+        std::vector<double>& shock() { return z_; }
+
+        template<typename Vol, typename Jump>
+        void advance(double* x, const Vol& vol, const Jump& jump, std::size_t n) const {
+            const double kdt = kdt_, mu = mu_;
+            const double* z = z_.data();
+            for (std::size_t i = 0; i < n; ++i) {
+                if constexpr (Jump::enabled) {
+                    x[i] += kdt * (mu - x[i]) + vol.scale(i) * z[i] + jump.size(i);
+                } else {
+                    x[i] += kdt * (mu - x[i]) + vol.scale(i) * z[i];
+                }
+            }
+        }
+
+    private:
+        double kdt_{}, mu_{};
+        std::vector<double> z_;
+    };
+
+    /// dS/S = drift dt + sigma dW, with jumps (if any) applied to log S; starts at mu
+    class GBM {
+    public:
+        using role = model::drift_role;
+
+        static double initial(const Params& p) { return p.mu; }
+
+        void configure(const Params& p, double dt) { drift_dt_ = p.drift * dt; }
+
+        void resize(std::size_t n) { z_.resize(n); }
+
+        void draw(const detail::RNG& rng, std::uint64_t first_stream, std::uint64_t base) {
+            rng.normal_lanes(z_, first_stream, base + 0);
+        }
+
+        std::vector<double>& shock() { return z_; }
+
+        template<typename Vol, typename Jump>
+        void advance(double* x, const Vol& vol, const Jump& jump, std::size_t n) const {
+            const double* z = z_.data();
+            for (std::size_t i = 0; i < n; ++i) {
+                const double s = vol.scale(i);
+                double log_ret = drift_dt_ - 0.5 * s * s + s * z[i];
+                if constexpr (Jump::enabled) log_ret += jump.size(i);
+                x[i] *= std::exp(log_ret);
+            }
+        }
+
+    private:
+        double drift_dt_{};
+        std::vector<double> z_;
+    };
+
+    /* ---------------- volatility ---------------- */
+
+    /// sigma0 for every symbol and step
+    class ConstantVol {
+    public:
+        using role = model::volatility_role;
+
+        void configure(const Params& p, double dt) { scale_ = p.sigma0 * std::sqrt(dt); }
+        void resize(std::size_t) {}
+        void draw(const detail::RNG&, std::uint64_t, std::uint64_t) {}
+        void advance(std::size_t) {}
+
+        double scale(std::size_t) const { return scale_; }
+
+    private:
+        double scale_{};
+    };
+
+    /// N-state Markov-switching volatility.
+    ///
+    /// N == 2 uses sigma0/sigma1 and p01/p10 (or regime_sigmas/regime_transitions
+    /// when given) with a branch-free two-state update. N > 2 needs
+    /// Params::regime_sigmas (N) and regime_transitions (N x N, row-major, rows
+    /// summing to 1). Every symbol starts in state 0.
+    template<std::size_t N>
+    class RegimeSwitch {
+        static_assert(N >= 2, "RegimeSwitch: needs at least two states");
+
+    public:
+        using role = model::volatility_role;
+
+        void configure(const Params& p, double dt) {
+            const double sqrt_dt = std::sqrt(dt);
+            const bool table = !p.regime_sigmas.empty() || !p.regime_transitions.empty();
+            if (table && (p.regime_sigmas.size() != N || p.regime_transitions.size() != N * N)) {
+                throw std::invalid_argument("RegimeSwitch: regime_sigmas/regime_transitions do not match N");
+            }
+            if constexpr (N == 2) {
+                const double s0 = table ? p.regime_sigmas[0] : p.sigma0;
+                const double s1 = table ? p.regime_sigmas[1] : p.sigma1;
+                p01_ = table ? p.regime_transitions[1] : p.p01;
+                p10_ = table ? p.regime_transitions[2] : p.p10;
+                s0_ = s0 * sqrt_dt;
+                ds_ = (s1 - s0) * sqrt_dt;
+            } else {
+                if (!table) throw std::invalid_argument("RegimeSwitch: N > 2 needs regime_sigmas and regime_transitions");
+                for (std::size_t r = 0; r < N; ++r) {
+                    sigma_[r] = p.regime_sigmas[r] * sqrt_dt;
+                    double cdf = 0.0;
+                    for (std::size_t k = 0; k < N; ++k) {
+                        cdf += p.regime_transitions[r * N + k];
+                        cdf_[r * N + k] = cdf;
+                    }
+                    if (std::abs(cdf - 1.0) > 1e-9) throw std::invalid_argument("RegimeSwitch: transition rows must sum to 1");
+                }
+            }
+        }
+
+        void resize(std::size_t n) {
+            regime_.assign(n, 0.0);
+            u_.resize(n);
+        }
+
+        void draw(const detail::RNG& rng, std::uint64_t first_stream, std::uint64_t base) {
+            rng.uniform_lanes(u_, first_stream, base + 1);
+        }
+
+        void advance(std::size_t n) {
+            double* r = regime_.data();
+            const double* u = u_.data();
+            if constexpr (N == 2) {
+                // r' = r ? (u >= p10) : (u < p01), written branch-free
+                const double p01 = p01_, p10 = p10_;
+                for (std::size_t i = 0; i < n; ++i) {
+                    const double up = u[i] < p01 ? 1.0 : 0.0;
+                    const double down = u[i] < p10 ? 1.0 : 0.0;
+                    r[i] = r[i] + (1.0 - r[i]) * up - r[i] * down;
+                }
+            } else {
+                // r' = #{k < N-1 : u >= cdf[r][k]}
+                for (std::size_t i = 0; i < n; ++i) {
+                    const double* row = cdf_.data() + static_cast<std::size_t>(r[i]) * N;
+                    double next = 0.0;
+                    for (std::size_t k = 0; k + 1 < N; ++k) next += u[i] >= row[k] ? 1.0 : 0.0;
+                    r[i] = next;
+                }
+            }
+        }
+
+        double scale(std::size_t i) const {
+            if constexpr (N == 2) return s0_ + ds_ * regime_[i];
+            else return sigma_[static_cast<std::size_t>(regime_[i])];
+        }
+
+        const std::vector<double>& regime() const { return regime_; }
+
+    private:
+        // N == 2
+        double p01_{}, p10_{}, s0_{}, ds_{};
+        // N > 2
+        std::array<double, N> sigma_{};
+        std::array<double, N * N> cdf_{};
+
+        std::vector<double> regime_;
+        std::vector<double> u_;
+    };
+
+    /* ---------------- jumps ---------------- */
+
+    /// Compound Poisson: J = K*jump_mean + sqrt(K)*jump_std*Z, K ~ Poisson(lambda_jump dt)
+    class Jumps {
+    public:
+        using role = model::jump_role;
+        static constexpr bool enabled = true;
+
+        void configure(const Params& p, double dt) {
+            mean_ = p.jump_mean;
+            stddev_ = p.jump_std;
+            build_cdf(p.lambda_jump * dt);
+        }
+
+        void resize(std::size_t n) {
+            u_.resize(n);
+            j_.resize(n);
+        }
+
+        void draw(const detail::RNG& rng, std::uint64_t first_stream, std::uint64_t base) {
+            rng.uniform_lanes(u_, first_stream, base + 2);
+            rng.normal_lanes(j_, first_stream, base + 3);
+        }
+
+        // K = #{k : cdf[k] < u}; lambda*dt is shared by all symbols so the CDF is a small table
+        void advance(std::size_t n) {
+            const double* u = u_.data();
+            double* j = j_.data(); // overwritten with the jump size J
+            for (std::size_t i = 0; i < n; ++i) {
+                double k = 0.0;
+                for (double c : cdf_) k += (c < u[i]) ? 1.0 : 0.0;
+                j[i] = k * mean_ + std::sqrt(k) * stddev_ * j[i];
+            }
+        }
+
+        double size(std::size_t i) const { return j_[i]; }
+
+    private:
+        void build_cdf(double lambda_dt) {
+            cdf_.clear();
+            if (lambda_dt <= 0.0) return;
+            // cut the table once the remaining tail mass is below double resolution
+            double pk = std::exp(-lambda_dt), cdf = pk;
+            for (int k = 1; k <= 64 && cdf < 1.0 - 1e-16; ++k) {
+                cdf_.push_back(cdf);
+                pk *= lambda_dt / k;
+                cdf += pk;
+            }
+            if (cdf_.empty()) cdf_.push_back(cdf);
+        }
+
+        double mean_{}, stddev_{};
+        std::vector<double> cdf_;
+        std::vector<double> u_, j_;
+    };
+
+    /* ---------------- microstructure ---------------- */
+
+    /// Transient noise, then quantization to the tick_size grid (at least one tick)
+    class Microstructure {
+    public:
+        using role = model::micro_role;
+        static constexpr bool enabled = true;
+
+        void configure(const Params& p, double) {
+            tick_ = p.tick_size;
+            inv_tick_ = 1.0 / p.tick_size;
+            micro_ = p.sigma_micro;
+        }
+
+        void resize(std::size_t n) { z_.resize(n); }
+
+        void draw(const detail::RNG& rng, std::uint64_t first_stream, std::uint64_t base) {
+            rng.normal_lanes(z_, first_stream, base + 4);
+        }
+
+        double quote(double x, std::size_t i) const {
+            return std::max(std::floor((x + micro_ * z_[i]) * inv_tick_ + 0.5), 1.0) * tick_;
+        }
+
+    private:
+        double tick_{}, inv_tick_{}, micro_{};
+        std::vector<double> z_;
+    };
+
+    /* ---------------- correlation ---------------- */
+
+    /// Correlated drift shocks, configured from Params (rows indexed like symbols):
+    ///   factor_loadings (N x factor_count):  Z_i = B_i . F + sqrt(1 - |B_i|^2) E_i
+    ///   correlation     (N x N):             Z = L E,  C = L L^T (Cholesky)
+    /// E are the per-symbol drift draws, F are factor_count common normals (RNG
+    /// streams factor_stream_base + k at the step's base position). N is the
+    /// global universe; a shard keeps only its own rows, so paths do not depend on
+    /// sharding. The factor form costs O(n K) per step and memory, the full matrix
+    /// O(n N). Both are factorized in set_params, and only when the matrix or the
+    /// loadings differ from the last factorized ones (a rate change keeps them);
+    /// with neither set, shocks stay independent at no cost.
+    class Correlated {
+    public:
+        using role = model::shock_role;
+        static constexpr std::uint64_t factor_stream_base = std::uint64_t{1} << 46;
+
+        void resize(std::size_t n, std::uint64_t first_stream) {
+            n_ = n;
+            first_ = static_cast<std::size_t>(first_stream);
+            configured_ = false;
+        }
+
+        void configure(const Params& p, double) {
+            if (!p.factor_loadings.empty() && !p.correlation.empty()) {
+                throw std::invalid_argument("Correlated: set either factor_loadings or correlation, not both");
+            }
+            // the factorization depends on these alone, not on dt
+            if (configured_ && p.factor_count == factor_count_ && p.factor_loadings == factor_loadings_
+                && p.correlation == correlation_) return;
+
+            configured_ = false;
+            mode_ = Mode::Independent;
+            loadings_ = {};
+            idio_ = {};
+            chol_ = {};
+            if (!p.factor_loadings.empty()) configure_factors(p);
+            if (!p.correlation.empty()) configure_cholesky(p);
+            factor_count_ = p.factor_count;
+            factor_loadings_ = p.factor_loadings;
+            correlation_ = p.correlation;
+            configured_ = true;
+        }
+
+        void apply(std::vector<double>& z, const detail::RNG& rng, std::uint64_t base) {
+            if (mode_ == Mode::Factors) apply_factors(z, rng, base);
+            else if (mode_ == Mode::Cholesky) apply_cholesky(z, rng, base);
+        }
+
+    private:
+        enum class Mode { Independent, Factors, Cholesky };
+
+        void configure_factors(const Params& p) {
+            const std::size_t k = p.factor_count;
+            if (k == 0 || p.factor_loadings.size() % k != 0) {
+                throw std::invalid_argument("Correlated: factor_loadings must be N x factor_count");
+            }
+            if (p.factor_loadings.size() / k < first_ + n_) {
+                throw std::invalid_argument("Correlated: factor_loadings has fewer rows than symbols");
+            }
+            // factor-major columns of this shard's rows: the kernel is k contiguous axpys
+            loadings_.assign(k * n_, 0.0);
+            idio_.assign(n_, 0.0);
+            for (std::size_t i = 0; i < n_; ++i) {
+                const double* row = p.factor_loadings.data() + (first_ + i) * k;
+                double norm = 0.0;
+                for (std::size_t f = 0; f < k; ++f) {
+                    loadings_[f * n_ + i] = row[f];
+                    norm += row[f] * row[f];
+                }
+                if (norm > 1.0 + 1e-12) throw std::invalid_argument("Correlated: factor loadings row norm exceeds 1");
+                idio_[i] = std::sqrt(std::max(1.0 - norm, 0.0));
+            }
+            factors_.resize(k);
+            mode_ = Mode::Factors;
+        }
+
+        void configure_cholesky(const Params& p) {
+            const std::size_t dim = static_cast<std::size_t>(std::llround(std::sqrt(static_cast<double>(p.correlation.size()))));
+            if (dim * dim != p.correlation.size()) throw std::invalid_argument("Correlated: correlation must be N x N");
+            if (dim < first_ + n_) throw std::invalid_argument("Correlated: correlation has fewer rows than symbols");
+
+            // rows [0, m) of L are needed to reach this shard's rows
+            const std::size_t m = first_ + n_;
+            const auto c = [&](std::size_t i, std::size_t j) { return p.correlation[i * dim + j]; };
+            std::vector<double> l(m * m, 0.0);
+            constexpr double tol = 1e-10;
+            for (std::size_t i = 0; i < m; ++i) {
+                if (std::abs(c(i, i) - 1.0) > 1e-9) throw std::invalid_argument("Correlated: correlation diagonal must be 1");
+                for (std::size_t j = 0; j <= i; ++j) {
+                    if (std::abs(c(i, j) - c(j, i)) > 1e-9) throw std::invalid_argument("Correlated: correlation must be symmetric");
+                    double s = c(i, j);
+                    for (std::size_t k = 0; k < j; ++k) s -= l[i * m + k] * l[j * m + k];
+                    if (i == j) {
+                        if (s < -tol) throw std::invalid_argument("Correlated: correlation is not positive semi-definite");
+                        l[i * m + i] = s > tol ? std::sqrt(s) : 0.0;
+                    } else if (l[j * m + j] > 0.0) {
+                        l[i * m + j] = s / l[j * m + j];
+                    } else if (std::abs(s) > 1e-8) {
+                        throw std::invalid_argument("Correlated: correlation is not positive semi-definite");
+                    }
+                }
+            }
+
+            // column-major copy of this shard's rows
+            chol_.assign(m * n_, 0.0);
+            for (std::size_t r = 0; r < n_; ++r) {
+                for (std::size_t j = 0; j <= first_ + r; ++j) chol_[j * n_ + r] = l[(first_ + r) * m + j];
+            }
+            universe_.resize(m);
+            mode_ = Mode::Cholesky;
+        }
+
+        void apply_factors(std::vector<double>& z, const detail::RNG& rng, std::uint64_t base) {
+            rng.normal_lanes(factors_, factor_stream_base, base);
+            double* out = z.data();
+            const double* idio = idio_.data();
+            for (std::size_t i = 0; i < n_; ++i) out[i] *= idio[i];
+            for (std::size_t f = 0; f < factors_.size(); ++f) {
+                const double ff = factors_[f];
+                const double* b = loadings_.data() + f * n_;
+                for (std::size_t i = 0; i < n_; ++i) out[i] += b[i] * ff;
+            }
+        }
+
+        // out = L E as column axpys over row blocks, so each block of out stays in L1
+        void apply_cholesky(std::vector<double>& z, const detail::RNG& rng, std::uint64_t base) {
+            // E for global symbols [0, first): the drift draws of the symbols before this shard
+            if (first_ != 0) rng.normal_lanes(std::span<double>(universe_.data(), first_), 0, base + 0);
+            std::copy(z.begin(), z.end(), universe_.begin() + static_cast<std::ptrdiff_t>(first_));
+
+            constexpr std::size_t block = 256;
+            double* out = z.data();
+            const double* e = universe_.data();
+            std::fill(z.begin(), z.end(), 0.0);
+            for (std::size_t r0 = 0; r0 < n_; r0 += block) {
+                const std::size_t r1 = std::min(n_, r0 + block);
+                const std::size_t cols = first_ + r1; // L is zero past the block's last row
+                for (std::size_t j = 0; j < cols; ++j) {
+                    const double ej = e[j];
+                    const double* col = chol_.data() + j * n_;
+                    for (std::size_t r = r0; r < r1; ++r) out[r] += col[r] * ej;
+                }
+            }
+        }
+
+        Mode mode_{Mode::Independent};
+        std::size_t n_{}, first_{};
+        std::vector<double> loadings_, idio_, factors_; // factor form
+        std::vector<double> chol_, universe_;           // full-matrix form
+
+        // inputs of the current factorization
+        bool configured_{false};
+        std::size_t factor_count_{};
+        std::vector<double> factor_loadings_, correlation_;
+    };
+
+    namespace model {
+        // stand-ins for omitted roles
+        struct NoJumps {
+            using role = jump_role;
+            static constexpr bool enabled = false;
+            void configure(const Params&, double) {}
+            void resize(std::size_t) {}
+            void draw(const detail::RNG&, std::uint64_t, std::uint64_t) {}
+            void advance(std::size_t) {}
+            static constexpr double size(std::size_t) { return 0.0; }
+        };
+
+        struct NoMicrostructure {
+            using role = micro_role;
+            static constexpr bool enabled = false;
+            void configure(const Params&, double) {}
+            void resize(std::size_t) {}
+            void draw(const detail::RNG&, std::uint64_t, std::uint64_t) {}
+            static double quote(double x, std::size_t) { return x; }
+        };
+
+        struct Independent {
+            using role = shock_role;
+            void configure(const Params&, double) {}
+            void resize(std::size_t, std::uint64_t) {}
+            void apply(std::vector<double>&, const detail::RNG&, std::uint64_t) {}
+        };
+
+        template<typename Role, typename Default, typename... Cs>
+        struct pick { using type = Default; };
+
+        template<typename Role, typename Default, typename C, typename... Cs>
+        struct pick<Role, Default, C, Cs...> {
+            using type = std::conditional_t<std::is_same_v<typename C::role, Role>, C,
+                                            typename pick<Role, Default, Cs...>::type>;
+        };
+
+        template<typename Role, typename... Cs>
+        inline constexpr std::size_t count = (std::size_t{0} + ... + std::is_same_v<typename Cs::role, Role>);
+    } // namespace model
+
+    /* ---------------- model ---------------- */
+
+    template<typename... Components>
+    class Model {
+        static_assert(model::count<model::drift_role, Components...> == 1, "Model: needs exactly one drift (OU or GBM)");
+        static_assert(model::count<model::volatility_role, Components...> <= 1, "Model: at most one volatility component");
+        static_assert(model::count<model::jump_role, Components...> <= 1, "Model: at most one jump component");
+        static_assert(model::count<model::micro_role, Components...> <= 1, "Model: at most one microstructure component");
+        static_assert(model::count<model::shock_role, Components...> <= 1, "Model: at most one correlation component");
+
+    public:
+        using Drift = typename model::pick<model::drift_role, void, Components...>::type;
+        using Volatility = typename model::pick<model::volatility_role, ConstantVol, Components...>::type;
+        using Jump = typename model::pick<model::jump_role, model::NoJumps, Components...>::type;
+        using Micro = typename model::pick<model::micro_role, model::NoMicrostructure, Components...>::type;
+        using Shock = typename model::pick<model::shock_role, model::Independent, Components...>::type;
+
+        static constexpr std::uint64_t draws_per_step = 6;
+
+        // first_stream: global index of symbol 0 of this model (RNG stream of that symbol)
+        Model(const Params& params, std::size_t n_symbols, std::uint64_t seed, std::uint64_t first_stream = 0)
+            : n_(n_symbols)
+            , first_stream_(first_stream)
+            , rng_(seed)
+            , x_(n_symbols, Drift::initial(params))
+            , u_volume_(n_symbols)
+            , price_(n_symbols), bid_(n_symbols), ask_(n_symbols), volume_(n_symbols) {
+            drift_.resize(n_symbols);
+            vol_.resize(n_symbols);
+            jump_.resize(n_symbols);
+            micro_.resize(n_symbols);
+            shock_.resize(n_symbols, first_stream);
+            set_params(params);
+        }
+
+        // recompute per-step constants (rate changes, parameter edits)
+        void set_params(const Params& params) {
+            if (params.rate_hz <= 0.0) throw std::invalid_argument("Model: rate_hz must be > 0");
+            if (params.tick_size <= 0.0) throw std::invalid_argument("Model: tick_size must be > 0");
+            dt_ = 1.0 / params.rate_hz;
+            tick_ = params.tick_size;
+            drift_.configure(params, dt_);
+            vol_.configure(params, dt_);
+            jump_.configure(params, dt_);
+            micro_.configure(params, dt_);
+            shock_.configure(params, dt_);
+        }
+
+        // advance every symbol by one dt
+        void step() {
+            const std::uint64_t base = step_ * draws_per_step;
+            drift_.draw(rng_, first_stream_, base);
+            vol_.draw(rng_, first_stream_, base);
+            jump_.draw(rng_, first_stream_, base);
+            micro_.draw(rng_, first_stream_, base);
+            rng_.uniform_lanes(u_volume_, first_stream_, base + 5);
+            shock_.apply(drift_.shock(), rng_, base);
+
+            vol_.advance(n_);
+            jump_.advance(n_);
+            drift_.advance(x_.data(), vol_, jump_, n_);
+            quote_kernel();
+            ++step_;
+        }
+
+        std::size_t size() const { return n_; }
+        double dt() const { return dt_; }
+        std::uint64_t steps() const { return step_; }
+
+        // output columns of the last step
+        const std::vector<double>& price() const { return price_; }
+        const std::vector<double>& bid() const { return bid_; }
+        const std::vector<double>& ask() const { return ask_; }
+        const std::vector<double>& volume() const { return volume_; }
+
+        // latent state
+        const std::vector<double>& level() const { return x_; }
+        const std::vector<double>& regime() const requires requires(const Volatility& v) { v.regime(); } {
+            return vol_.regime();
+        }
+
+    private:
+        void quote_kernel() {
+            const double tick = tick_;
+            const double* x = x_.data();
+            const double* uv = u_volume_.data();
+            for (std::size_t i = 0; i < n_; ++i) {
+                const double p = micro_.quote(x[i], i);
+                price_[i] = p;
+                bid_[i] = p - tick;
+                ask_[i] = p + tick;
+                volume_[i] = std::floor(-100.0 * std::log(1.0 - uv[i])) + 1.0; // exponential lots, mean ~100
+            }
+        }
+
+        std::size_t n_;
+        std::uint64_t first_stream_;
+        std::uint64_t step_{0};
+        double dt_{};
+        double tick_{};
+        detail::RNG rng_;
+
+        Drift drift_;
+        Volatility vol_;
+        Jump jump_;
+        Micro micro_;
+        Shock shock_;
+
+        std::vector<double> x_;
+        std::vector<double> u_volume_;
+        std::vector<double> price_, bid_, ask_, volume_;
+    };
+
+    using DefaultModel = Model<OU, RegimeSwitch<2>, Jumps, Microstructure, Correlated>;
+
+    namespace detail {
+        /// Type-erased model for StreamGen: one virtual call per universe step,
+        /// output columns are read through stable pointers.
+        class AnyModel {
+        public:
+            virtual ~AnyModel() = default;
+            virtual void step() = 0;
+            virtual void set_params(const Params& params) = 0;
+            virtual std::size_t size() const = 0;
+            virtual const double* price() const = 0;
+            virtual const double* bid() const = 0;
+            virtual const double* ask() const = 0;
+            virtual const double* volume() const = 0;
+        };
+
+        template<typename M>
+        class ModelAdapter final : public AnyModel {
+        public:
+            ModelAdapter(const Params& params, std::size_t n, std::uint64_t seed) : model_(params, n, seed) {}
+
+            void step() override { model_.step(); }
+            void set_params(const Params& params) override { model_.set_params(params); }
+            std::size_t size() const override { return model_.size(); }
+            const double* price() const override { return model_.price().data(); }
+            const double* bid() const override { return model_.bid().data(); }
+            const double* ask() const override { return model_.ask().data(); }
+            const double* volume() const override { return model_.volume().data(); }
+
+        private:
+            M model_;
+        };
+    } // namespace detail
+
+} // namespace tickstream
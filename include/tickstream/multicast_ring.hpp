@@ -0,0 +1,197 @@
+// include/tickstream/multicast_ring.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "detail/cache_line.hpp"
+
+namespace tickstream {
+
+    /// Cache-padded, monotonically increasing sequence number (-1 => nothing yet).
+    class Sequence {
+    public:
+        static constexpr std::int64_t initial = -1;
+
+        explicit Sequence(std::int64_t value = initial) : value_(value) {}
+
+        std::int64_t get() const { return value_.load(std::memory_order_acquire); }
+        void set(std::int64_t value) { value_.store(value, std::memory_order_release); }
+
+    private:
+        alignas(detail::cache_line_size) std::atomic<std::int64_t> value_;
+        char pad_[detail::cache_line_size - sizeof(std::atomic<std::int64_t>)];
+    };
+
+    /// Highest sequence a stage may read: published by the producer and
+    /// already processed by every stage it depends on.
+    class SequenceBarrier {
+    public:
+        SequenceBarrier(const Sequence& cursor, std::vector<const Sequence*> dependencies)
+            : cursor_(&cursor), dependencies_(std::move(dependencies)) {}
+
+        std::int64_t available() const {
+            std::int64_t seq = cursor_->get();
+            for (const Sequence* dep : dependencies_) seq = std::min(seq, dep->get());
+            return seq;
+        }
+
+    private:
+        const Sequence* cursor_;
+        std::vector<const Sequence*> dependencies_;
+    };
+
+    /// Single-producer, multi-consumer broadcast ring (Disruptor-style).
+    ///
+    /// Every reader keeps its own Sequence and sees every published element;
+    /// nothing is copied per reader. The producer is gated on the slowest
+    /// registered reader. Gating sequences live in a fixed array of max_readers
+    /// atomic slots, so readers may join and leave while the producer publishes;
+    /// a reader that joins late starts at the current cursor.
+    template <typename T>
+    class MulticastRing {
+    public:
+        explicit MulticastRing(std::size_t capacity, std::size_t max_readers = 16)
+            : gating_(std::make_unique<std::atomic<const Sequence*>[]>(max_readers))
+            , max_readers_(max_readers)
+            , capacity_(std::bit_ceil(std::max<std::size_t>(capacity, 1)))
+            , mask_(capacity_ - 1)
+            , buffer_(capacity_) {}
+
+        MulticastRing(const MulticastRing&) = delete;
+        MulticastRing& operator=(const MulticastRing&) = delete;
+
+        // ---------------- producer side ----------------
+
+        // claim the next n sequences; returns the highest claimed, or -1 if the
+        // slowest reader is less than n slots behind a full ring
+        std::int64_t try_claim(std::size_t n = 1) {
+            const std::int64_t next = claimed_ + static_cast<std::int64_t>(n);
+            const std::int64_t wrap = next - static_cast<std::int64_t>(capacity_);
+            if (wrap > gate_cache_) {
+                gate_cache_ = min_gating(claimed_);
+                if (wrap > gate_cache_) return -1;
+            }
+            claimed_ = next;
+            return next;
+        }
+
+        // make every claimed sequence up to and including seq visible to readers
+        void publish(std::int64_t seq) { cursor_.set(seq); }
+
+        bool try_publish(const T& item) {
+            const std::int64_t seq = try_claim();
+            if (seq < 0) return false;
+            (*this)[seq] = item;
+            publish(seq);
+            return true;
+        }
+
+        T& operator[](std::int64_t seq) { return buffer_[static_cast<std::size_t>(seq) & mask_]; }
+        const T& operator[](std::int64_t seq) const { return buffer_[static_cast<std::size_t>(seq) & mask_]; }
+
+        // ---------------- wiring ----------------
+
+        // any thread; throws when all max_readers slots are taken
+        void add_gating_sequence(const Sequence& seq) {
+            for (std::size_t i = 0; i < max_readers_; ++i) {
+                const Sequence* expected = nullptr;
+                if (gating_[i].compare_exchange_strong(expected, &seq, std::memory_order_acq_rel)) return;
+            }
+            throw std::length_error("MulticastRing: more than max_readers gating sequences");
+        }
+
+        void remove_gating_sequence(const Sequence& seq) {
+            for (std::size_t i = 0; i < max_readers_; ++i) {
+                const Sequence* expected = &seq;
+                if (gating_[i].compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) return;
+            }
+        }
+
+        SequenceBarrier new_barrier(std::vector<const Sequence*> dependencies = {}) const {
+            return SequenceBarrier(cursor_, std::move(dependencies));
+        }
+
+        const Sequence& cursor() const { return cursor_; }
+        std::size_t capacity() const { return capacity_; }
+
+    private:
+        std::int64_t min_gating(std::int64_t fallback) const {
+            std::int64_t seq = fallback;
+            for (std::size_t i = 0; i < max_readers_; ++i) {
+                if (const Sequence* s = gating_[i].load(std::memory_order_acquire)) seq = std::min(seq, s->get());
+            }
+            return seq;
+        }
+
+        // producer-owned
+        alignas(detail::cache_line_size) std::int64_t claimed_{Sequence::initial};
+        std::int64_t gate_cache_{Sequence::initial};
+
+        // registered readers (null => free slot)
+        std::unique_ptr<std::atomic<const Sequence*>[]> gating_;
+        const std::size_t max_readers_;
+
+        // shared: published cursor (padded itself)
+        Sequence cursor_;
+
+        // read-only after construction
+        const std::size_t capacity_;
+        const std::size_t mask_;
+        std::vector<T> buffer_;
+    };
+
+    /// One consumer stage on a MulticastRing: its own read Sequence plus a barrier
+    /// on the producer cursor and on any upstream stages it must trail.
+    template <typename T>
+    class MulticastReader {
+    public:
+        explicit MulticastReader(MulticastRing<T>& ring, std::vector<const Sequence*> depends_on = {})
+            : ring_(ring)
+            , barrier_(ring.new_barrier(std::move(depends_on)))
+            , sequence_(ring.cursor().get()) {
+            ring_.add_gating_sequence(sequence_);
+            // a producer that gated before seeing us only wrote past the cursor read now
+            sequence_.set(ring.cursor().get());
+        }
+
+        ~MulticastReader() { ring_.remove_gating_sequence(sequence_); }
+
+        MulticastReader(const MulticastReader&) = delete;
+        MulticastReader& operator=(const MulticastReader&) = delete;
+
+        // hand every available element to f(item, seq, end_of_batch), then advance
+        // this stage's sequence once for the whole batch; returns how many were seen
+        template <typename F>
+        std::size_t poll(F&& f, std::size_t max_batch = std::numeric_limits<std::size_t>::max()) {
+            const std::int64_t from = sequence_.get() + 1;
+            std::int64_t to = barrier_.available();
+            if (to < from) return 0;
+            if (static_cast<std::uint64_t>(to - from) >= max_batch) to = from + static_cast<std::int64_t>(max_batch) - 1;
+
+            for (std::int64_t seq = from; seq <= to; ++seq) {
+                f(std::as_const(ring_)[seq], seq, seq == to);
+            }
+            sequence_.set(to);
+            return static_cast<std::size_t>(to - from + 1);
+        }
+
+        // downstream stages pass this to depends_on
+        const Sequence& sequence() const { return sequence_; }
+
+    private:
+        MulticastRing<T>& ring_;
+        SequenceBarrier barrier_;
+        Sequence sequence_;
+    };
+
+} // namespace tickstream
@@ -0,0 +1,176 @@
+// include/tickstream/offline.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "params.hpp"
+#include "symbols.hpp"
+#include "tick.hpp"
+#include "detail/models.hpp"
+#include "detail/rng.h"
+#include "detail/thread_pool.hpp"
+
+namespace tickstream {
+
+    struct OfflineOptions {
+        std::uint64_t steps = 0;              // steps per symbol (one tick each); 0 => params.max_count
+        std::uint64_t start_unix_ns = 0;      // simulated wall clock of step 0
+        std::size_t threads = 0;              // 0 => hardware_concurrency
+        std::size_t symbols_per_shard = 64;   // work unit width
+        std::uint64_t steps_per_window = 1024; // work unit length; windows are merged in order
+    };
+
+    /// As-fast-as-possible generation on simulated time.
+    ///
+    /// Symbols are sharded into fixed-width engines (each owning its slice of the
+    /// SoA state) and time is cut into windows. Per window every shard is a task on
+    /// a work-stealing pool; the calling thread merges window w into timestamp order
+    /// while the pool computes window w+1. Draws are counter-addressed by (symbol,
+    /// step), and ties are broken by symbol index, so the emitted sequence is
+    /// bit-identical for a given seed regardless of threads, shard width or window
+    /// length.
+    ///
+    /// Tick k of symbol i is stamped start + k*dt + jitter, with jitter drawn in
+    /// [0, min(latency_jitter_ms, dt)) so each symbol's ticks stay in step order.
+    /// sink receives consecutive runs of the merged stream.
+    inline void generate_offline(const Params& params, const OfflineOptions& options,
+                                 const std::function<void(std::span<const FlatTick>)>& sink) {
+        if (params.symbols.empty()) throw std::invalid_argument("generate_offline: params.symbols is empty");
+        if (params.seed == 0) throw std::invalid_argument("generate_offline: needs an explicit seed");
+        if (params.rate_hz <= 0.0) throw std::invalid_argument("generate_offline: rate_hz must be > 0");
+        const auto dt_ns = static_cast<std::uint64_t>(std::llround(1e9 / params.rate_hz));
+        if (dt_ns == 0) throw std::invalid_argument("generate_offline: rate_hz above the 1ns clock resolution");
+
+        const std::uint64_t steps = options.steps != 0 ? options.steps : params.max_count;
+        if (steps == 0) throw std::invalid_argument("generate_offline: unbounded run (steps and max_count are 0)");
+
+        const std::size_t n = params.symbols.size();
+        const std::size_t width = std::max<std::size_t>(options.symbols_per_shard, 1);
+        const std::size_t shard_count = (n + width - 1) / width;
+        const std::uint64_t window = std::max<std::uint64_t>(options.steps_per_window, 1);
+
+        const double jitter_ns = std::min(params.latency_jitter_ms * 1e6, static_cast<double>(dt_ns - 1));
+        constexpr std::uint64_t jitter_stream_base = std::uint64_t{1} << 48; // disjoint from engine streams
+        const detail::RNG jitter_rng(params.seed);
+
+        std::vector<SymbolId> ids(n);
+        for (std::size_t i = 0; i < n; ++i) ids[i] = SymbolRegistry::global().intern(params.symbols[i]);
+
+        struct Shard {
+            std::size_t first;
+            std::unique_ptr<detail::MultiSymbolEngine> engine;
+            std::vector<double> jitter;
+            std::vector<FlatTick> out[2]; // double-buffered by window parity
+        };
+        std::vector<Shard> shards(shard_count);
+        for (std::size_t s = 0; s < shard_count; ++s) {
+            const std::size_t first = s * width, count = std::min(width, n - first);
+            shards[s].first = first;
+            shards[s].engine = std::make_unique<detail::MultiSymbolEngine>(params, count, params.seed, first);
+            shards[s].jitter.resize(count);
+        }
+
+        // merge key: (timestamp, symbol index); unique because a symbol emits once per step
+        const auto before = [&](const FlatTick& a, const FlatTick& b) {
+            return a.mono_ts_ns != b.mono_ts_ns ? a.mono_ts_ns < b.mono_ts_ns : a.symbol_id < b.symbol_id;
+        };
+
+        const auto compute = [&](std::size_t s, std::uint64_t w) {
+            Shard& shard = shards[s];
+            detail::MultiSymbolEngine& engine = *shard.engine;
+            const std::size_t count = engine.size();
+            const std::uint64_t begin = w * window, end = std::min(steps, begin + window);
+
+            auto& out = shard.out[w & 1];
+            out.resize(static_cast<std::size_t>(end - begin) * count);
+            std::size_t o = 0;
+            for (std::uint64_t k = begin; k < end; ++k) {
+                engine.step();
+                if (jitter_ns > 0.0) {
+                    jitter_rng.uniform_lanes(shard.jitter, jitter_stream_base + shard.first, k, 0.0, jitter_ns);
+                }
+                for (std::size_t i = 0; i < count; ++i, ++o) {
+                    const std::uint64_t offset = k * dt_ns + static_cast<std::uint64_t>(shard.jitter[i]);
+                    FlatTick& t = out[o];
+                    t.price = engine.price()[i];
+                    t.volume = engine.volume()[i];
+                    t.bid = engine.bid()[i];
+                    t.ask = engine.ask()[i];
+                    t.unix_ts_ns = options.start_unix_ns + offset;
+                    t.mono_ts_ns = offset;
+                    t.symbol_id = static_cast<SymbolId>(shard.first + i); // global index until merged
+                    t.sequence = static_cast<std::uint32_t>(k);
+                    t.n_bids = 0;
+                    t.n_asks = 0;
+                    t.is_snapshot = false;
+                }
+            }
+            std::sort(out.begin(), out.end(), before);
+        };
+
+        // k-way merge of one window's shard buffers (heap of shard cursors)
+        std::vector<FlatTick> merged;
+        const auto merge = [&](std::uint64_t w) {
+            struct Cursor { const FlatTick* it; const FlatTick* end; };
+            std::vector<Cursor> heap;
+            std::size_t total = 0;
+            for (auto& shard : shards) {
+                const auto& out = shard.out[w & 1];
+                if (!out.empty()) heap.push_back({out.data(), out.data() + out.size()});
+                total += out.size();
+            }
+            const auto later = [&](const Cursor& a, const Cursor& b) { return before(*b.it, *a.it); };
+            std::make_heap(heap.begin(), heap.end(), later);
+
+            merged.resize(total);
+            std::size_t o = 0;
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                Cursor& c = heap.back();
+                FlatTick& t = merged[o++];
+                t = *c.it++;
+                t.symbol_id = ids[t.symbol_id];
+                if (c.it == c.end) heap.pop_back();
+                else std::push_heap(heap.begin(), heap.end(), later);
+            }
+            sink(std::span<const FlatTick>(merged.data(), merged.size()));
+        };
+
+        detail::WorkStealingPool pool(options.threads);
+        const std::uint64_t windows = (steps + window - 1) / window;
+        auto pending = pool.submit(shard_count, [&](std::size_t s) { compute(s, 0); });
+        for (std::uint64_t w = 0; w < windows; ++w) {
+            pool.wait(*pending);
+            if (w + 1 < windows) {
+                pending = pool.submit(shard_count, [&, next = w + 1](std::size_t s) { compute(s, next); });
+            }
+            try {
+                merge(w);
+            } catch (...) {
+                // the sink threw: let the next window's tasks finish before the
+                // shard buffers they write go out of scope
+                try { pool.wait(*pending); } catch (...) {}
+                throw;
+            }
+        }
+    }
+
+    // convenience: collect everything in memory
+    inline std::vector<FlatTick> generate_offline(const Params& params, const OfflineOptions& options) {
+        std::vector<FlatTick> all;
+        generate_offline(params, options, [&](std::span<const FlatTick> run) {
+            all.insert(all.end(), run.begin(), run.end());
+        });
+        return all;
+    }
+
+} // namespace tickstream
@@ -21,12 +21,24 @@ namespace tickstream {
         double mu{100.0};
         double kappa{0.5};
 
+        // GBM drift (Model<GBM, ...>): dS/S = drift dt + sigma dW, per second
+        double drift{0.0};
+
         // Regime-switching volatility (two-state Markov chain)
         double sigma0{0.10};
         double sigma1{0.40};
         double p01{0.001};                    // P(0→1) per step
         double p10{0.002};                    // P(1→0) per step
 
+        // N-state volatility (Model<..., RegimeSwitch<N>>); empty => sigma0/sigma1, p01/p10
+        std::vector<double> regime_sigmas{};      // N vols, same units as sigma0
+        std::vector<double> regime_transitions{}; // N x N row-major, P(i→j) per step
+
+        // Correlated drift shocks, rows indexed like symbols; set at most one form
+        std::vector<double> correlation{};        // N x N row-major, unit diagonal, PSD
+        std::vector<double> factor_loadings{};    // N x factor_count row-major, row norms <= 1
+        std::size_t factor_count{0};
+
         // Jumps (compound Poisson)
         double lambda_jump{0.01};             // expected jumps per second
         double jump_mean{0.0};
@@ -2,47 +2,146 @@
 
 #pragma once
 
-#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include "ring_buffer.hpp"
+#include "scheduler.hpp"
 #include "tick.hpp"
+#include "wait_strategy.hpp"
 
 namespace tickstream {
 
+    /// Periodic producer: calls the callback once per interval and pushes the result.
+    /// Producers sharing a Scheduler are multiplexed onto its threads; a standalone
+    /// Producer owns a private single-threaded Scheduler.
+    ///
+    /// A full buffer is handled by the OverflowPolicy; drops and evictions are counted
+    /// per producer. Under Block (the default) the tick is held and retried on the
+    /// next fire, and no new tick is generated meanwhile, so a slow consumer slows
+    /// this producer without stalling the scheduler thread it shares with others.
     template<typename T>
     class Producer {
     public:
         using Callback = std::function<T()>;
-        
-        Producer(RingBuffer<T>& buffer, Callback callback, std::chrono::milliseconds interval)
-            : buffer_(buffer), callback_(callback), interval_(interval), running_(false) {}
-        
+
+        Producer(RingBuffer<T>& buffer, Callback callback, std::chrono::nanoseconds interval,
+                 std::chrono::nanoseconds jitter = std::chrono::nanoseconds::zero())
+            : owned_(std::make_unique<Scheduler>())
+            , scheduler_(owned_.get())
+            , buffer_(buffer), callback_(std::move(callback)), interval_(interval), jitter_(jitter) {}
+
+        Producer(Scheduler& scheduler, RingBuffer<T>& buffer, Callback callback, std::chrono::nanoseconds interval,
+                 std::chrono::nanoseconds jitter = std::chrono::nanoseconds::zero())
+            : scheduler_(&scheduler)
+            , buffer_(buffer), callback_(std::move(callback)), interval_(interval), jitter_(jitter) {}
+
+        ~Producer() { stop(); }
+
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+
+        // configure before start()
+        void set_overflow_policy(OverflowPolicy policy) {
+            if (policy == OverflowPolicy::OverwriteOldest) {
+                if (!std::is_trivially_copyable_v<T>) throw std::invalid_argument("Producer: OverwriteOldest needs a trivially copyable T");
+                if (!buffer_.overwritable()) throw std::invalid_argument("Producer: OverwriteOldest needs an overwritable RingBuffer");
+            }
+            policy_ = policy;
+        }
+
+        // shared with the consumer of the same buffer; signalled after every push
+        void set_wait_strategy(WaitStrategy& wait) { wait_ = &wait; }
+
         void start() {
-            running_ = true;
-            thread_ = std::thread([this]() {
-                while (running_) {
-                    T tick = callback_();
-                    while (!buffer_.try_push(tick)) {
-                        // Buffer full - wait or drop
-                        std::this_thread::sleep_for(std::chrono::microseconds(10));
-                    }
-                    std::this_thread::sleep_for(interval_);
-                }
-            });
+            if (running_.exchange(true)) return;
+            task_ = scheduler_->add([this] { emit(); }, interval_, jitter_);
+            if (owned_) owned_->start();
         }
-        
+
         void stop() {
-            running_ = false;
-            if (thread_.joinable()) thread_.join();
+            if (!running_.exchange(false)) return;
+            scheduler_->remove(task_);
+            if (owned_) owned_->stop();
+            if (pending_) { // stopped while full
+                pending_.reset();
+                bump(dropped_);
+            }
+            back_pressured_.store(false, std::memory_order_relaxed);
         }
-        
+
+        bool running() const { return running_.load(std::memory_order_relaxed); }
+        OverflowPolicy overflow_policy() const { return policy_; }
+
+        // counters (relaxed; read from any thread)
+        std::uint64_t produced() const { return produced_.load(std::memory_order_relaxed); }
+        std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+        std::uint64_t overwritten() const { return overwritten_.load(std::memory_order_relaxed); }
+
+        // Block only: a tick is waiting for room in the buffer
+        bool back_pressured() const { return back_pressured_.load(std::memory_order_relaxed); }
+
     private:
+        void emit() {
+            if (pending_) { // Block: retry the held tick before generating another
+                if (!buffer_.try_push(*pending_)) return;
+                pending_.reset();
+                back_pressured_.store(false, std::memory_order_relaxed);
+                wait_->signal();
+                return;
+            }
+
+            T tick = callback_();
+            bump(produced_);
+
+            switch (policy_) {
+            case OverflowPolicy::Block:
+                if (!buffer_.try_push(tick)) {
+                    pending_.emplace(std::move(tick));
+                    back_pressured_.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                break;
+            case OverflowPolicy::DropNewest:
+                if (!buffer_.try_push(tick)) { bump(dropped_); return; }
+                break;
+            case OverflowPolicy::OverwriteOldest:
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    if (!buffer_.push_overwrite(tick)) bump(overwritten_);
+                }
+                break;
+            }
+            wait_->signal();
+        }
+
+        // single writer (the scheduler thread running this task): no RMW needed
+        static void bump(std::atomic<std::uint64_t>& c) {
+            c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        std::unique_ptr<Scheduler> owned_;
+        Scheduler* scheduler_;
         RingBuffer<T>& buffer_;
         Callback callback_;
-        std::chrono::milliseconds interval_;
-        std::thread thread_;
-        std::atomic<bool> running_;
-    };
-}
+        std::chrono::nanoseconds interval_;
+        std::chrono::nanoseconds jitter_;
+        Scheduler::TaskId task_{0};
+        std::atomic<bool> running_{false};
+        std::optional<T> pending_;                   // Block: tick waiting for room
+        std::atomic<bool> back_pressured_{false};
 
+        OverflowPolicy policy_{OverflowPolicy::Block};
+        WaitStrategy default_wait_{WaitKind::SpinYield};
+        WaitStrategy* wait_{&default_wait_};
 
+        std::atomic<std::uint64_t> produced_{0};
+        std::atomic<std::uint64_t> dropped_{0};
+        std::atomic<std::uint64_t> overwritten_{0};
+    };
+}
@@ -0,0 +1,441 @@
+// include/tickstream/recording.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "detail/cpu_relax.hpp"
+#include "ring_buffer.hpp"
+#include "symbols.hpp"
+#include "tick.hpp"
+
+namespace tickstream {
+
+    /* On-disk columnar tick format (native endianness, 8-byte aligned sections)
+     *
+     *   FileHeader
+     *   Block 0: BlockHeader, then `count` entries per column:
+     *            price f64 | volume f64 | bid f64 | ask f64 |
+     *            unix_ts_ns u64 | mono_ts_ns u64 | symbol u32 (pad) | sequence u32 (pad)
+     *   Block 1 ...
+     *   Symbol table: symbol_count x { u32 length, bytes } (file-local ids)
+     *
+     * Only top of book is recorded; depth travels as book deltas.
+     */
+    namespace recording {
+
+        inline constexpr char magic[8] = {'T', 'S', 'T', 'K', 'C', 'O', 'L', '1'};
+        inline constexpr std::uint32_t version = 1;
+
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t block_capacity;
+            std::uint64_t tick_count;
+            std::uint64_t block_count;
+            std::uint64_t symbol_table_offset;
+            std::uint32_t symbol_count;
+            std::uint32_t reserved[5];
+        };
+        static_assert(sizeof(FileHeader) == 64);
+
+        struct BlockHeader {
+            std::uint32_t count;
+            std::uint32_t reserved;
+            std::uint64_t first_mono_ts_ns;
+            std::uint64_t last_mono_ts_ns;
+            std::uint64_t bytes; // block size including this header
+        };
+        static_assert(sizeof(BlockHeader) == 32);
+
+        constexpr std::size_t padded(std::size_t bytes) { return (bytes + 7) & ~std::size_t{7}; }
+
+        constexpr std::size_t block_bytes(std::size_t count) {
+            return sizeof(BlockHeader) + 6 * count * 8 + 2 * padded(count * 4);
+        }
+
+    } // namespace recording
+
+    /// Buffers ticks column-wise and writes one block per block_capacity ticks.
+    /// Usable directly as a Consumer handler: consumer.subscribe(std::ref(recorder)).
+    class TickRecorder {
+    public:
+        explicit TickRecorder(const std::string& path, std::size_t block_capacity = 65536,
+                              const SymbolRegistry& registry = SymbolRegistry::global())
+            : registry_(registry)
+            , capacity_(std::max<std::size_t>(block_capacity, 1)) {
+            file_ = std::fopen(path.c_str(), "wb");
+            if (!file_) throw std::runtime_error("TickRecorder: cannot open " + path);
+            std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+
+            recording::FileHeader header{}; // placeholder, rewritten by close()
+            write(&header, sizeof(header));
+            for (auto* col : {&price_, &volume_, &bid_, &ask_}) col->reserve(capacity_);
+            for (auto* col : {&unix_ts_, &mono_ts_}) col->reserve(capacity_);
+            for (auto* col : {&symbol_, &sequence_}) col->reserve(capacity_);
+        }
+
+        ~TickRecorder() {
+            try { close(); } catch (...) {}
+        }
+
+        TickRecorder(const TickRecorder&) = delete;
+        TickRecorder& operator=(const TickRecorder&) = delete;
+
+        void append(const FlatTick& t) {
+            push(t.price, t.volume, t.bid, t.ask, t.unix_ts_ns, t.mono_ts_ns, file_id(t.symbol_id), t.sequence);
+        }
+
+        void append(const Tick& t) {
+            push(t.price, t.volume, t.bid, t.ask, t.unix_ts_ns, t.mono_ts_ns, file_id(t.symbol), t.sequence);
+        }
+
+        void append(std::span<const FlatTick> ticks) {
+            for (const auto& t : ticks) append(t);
+        }
+
+        void operator()(const FlatTick& t) { append(t); }
+        void operator()(const Tick& t) { append(t); }
+
+        // write the pending partial block
+        void flush() {
+            if (!price_.empty()) write_block();
+            if (file_) std::fflush(file_);
+        }
+
+        // flush, append the symbol table and finalize the header; idempotent
+        void close() {
+            if (!file_) return;
+            flush();
+            recording::FileHeader header{};
+            std::memcpy(header.magic, recording::magic, sizeof(header.magic));
+            header.version = recording::version;
+            header.block_capacity = static_cast<std::uint32_t>(capacity_);
+            header.tick_count = tick_count_;
+            header.block_count = block_count_;
+            header.symbol_table_offset = offset_;
+            header.symbol_count = static_cast<std::uint32_t>(names_.size());
+
+            for (const auto& name : names_) {
+                const auto len = static_cast<std::uint32_t>(name.size());
+                write(&len, sizeof(len));
+                write(name.data(), name.size());
+            }
+            std::fseek(file_, 0, SEEK_SET);
+            write(&header, sizeof(header));
+            const bool failed = std::fclose(file_) != 0;
+            file_ = nullptr;
+            if (failed) throw std::runtime_error("TickRecorder: close failed");
+        }
+
+        std::uint64_t tick_count() const { return tick_count_ + price_.size(); }
+
+    private:
+        void push(double price, double volume, double bid, double ask,
+                  std::uint64_t unix_ts, std::uint64_t mono_ts, std::uint32_t symbol, std::uint32_t sequence) {
+            price_.push_back(price);
+            volume_.push_back(volume);
+            bid_.push_back(bid);
+            ask_.push_back(ask);
+            unix_ts_.push_back(unix_ts);
+            mono_ts_.push_back(mono_ts);
+            symbol_.push_back(symbol);
+            sequence_.push_back(sequence);
+            if (price_.size() == capacity_) write_block();
+        }
+
+        std::uint32_t file_id(SymbolId id) {
+            if (id < by_registry_id_.size() && by_registry_id_[id] != unmapped) return by_registry_id_[id];
+            return file_id(registry_.name(id), id);
+        }
+
+        std::uint32_t file_id(std::string_view name, SymbolId registry_id = unmapped) {
+            auto it = by_name_.find(std::string(name));
+            std::uint32_t fid;
+            if (it != by_name_.end()) {
+                fid = it->second;
+            } else {
+                fid = static_cast<std::uint32_t>(names_.size());
+                names_.emplace_back(name);
+                by_name_.emplace(names_.back(), fid);
+            }
+            if (registry_id != unmapped) {
+                if (registry_id >= by_registry_id_.size()) by_registry_id_.resize(registry_id + 1, unmapped);
+                by_registry_id_[registry_id] = fid;
+            }
+            return fid;
+        }
+
+        template <typename C>
+        void write_column(const std::vector<C>& col) {
+            write(col.data(), col.size() * sizeof(C));
+            static constexpr char zeros[8] = {};
+            const std::size_t bytes = col.size() * sizeof(C);
+            write(zeros, recording::padded(bytes) - bytes);
+        }
+
+        void write_block() {
+            const std::size_t n = price_.size();
+            recording::BlockHeader block{static_cast<std::uint32_t>(n), 0, mono_ts_.front(), mono_ts_.back(),
+                                         recording::block_bytes(n)};
+            write(&block, sizeof(block));
+            write_column(price_);
+            write_column(volume_);
+            write_column(bid_);
+            write_column(ask_);
+            write_column(unix_ts_);
+            write_column(mono_ts_);
+            write_column(symbol_);
+            write_column(sequence_);
+
+            tick_count_ += n;
+            ++block_count_;
+            for (auto* col : {&price_, &volume_, &bid_, &ask_}) col->clear();
+            for (auto* col : {&unix_ts_, &mono_ts_}) col->clear();
+            for (auto* col : {&symbol_, &sequence_}) col->clear();
+        }
+
+        void write(const void* data, std::size_t bytes) {
+            if (bytes == 0) return;
+            if (std::fwrite(data, 1, bytes, file_) != bytes) throw std::runtime_error("TickRecorder: write failed");
+            offset_ += bytes;
+        }
+
+        static constexpr std::uint32_t unmapped = ~std::uint32_t{0};
+
+        const SymbolRegistry& registry_;
+        std::size_t capacity_;
+        std::FILE* file_{nullptr};
+        std::uint64_t offset_{0};
+        std::uint64_t tick_count_{0};
+        std::uint64_t block_count_{0};
+
+        // pending block, column-wise
+        std::vector<double> price_, volume_, bid_, ask_;
+        std::vector<std::uint64_t> unix_ts_, mono_ts_;
+        std::vector<std::uint32_t> symbol_, sequence_;
+
+        // file-local symbol table
+        std::vector<std::string> names_;
+        std::unordered_map<std::string, std::uint32_t> by_name_;
+        std::vector<std::uint32_t> by_registry_id_;
+    };
+
+    /// Zero-copy view of one recorded block.
+    struct TickColumns {
+        std::size_t count;
+        std::span<const double> price, volume, bid, ask;
+        std::span<const std::uint64_t> unix_ts_ns, mono_ts_ns;
+        std::span<const std::uint32_t> symbol, sequence; // symbol: file-local id
+    };
+
+    /// Memory-mapped reader for files written by TickRecorder.
+    class TickFile {
+    public:
+        explicit TickFile(const std::string& path, SymbolRegistry& registry = SymbolRegistry::global()) {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("TickFile: cannot open " + path);
+            struct stat st{};
+            if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(recording::FileHeader))) {
+                ::close(fd);
+                throw std::runtime_error("TickFile: truncated file " + path);
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED) throw std::runtime_error("TickFile: mmap failed for " + path);
+            base_ = static_cast<const std::byte*>(map);
+            ::madvise(map, size_, MADV_SEQUENTIAL);
+
+            try {
+                index(registry);
+            } catch (...) {
+                ::munmap(const_cast<std::byte*>(base_), size_);
+                throw;
+            }
+        }
+
+        ~TickFile() {
+            if (base_) ::munmap(const_cast<std::byte*>(base_), size_);
+        }
+
+        TickFile(const TickFile&) = delete;
+        TickFile& operator=(const TickFile&) = delete;
+
+        std::uint64_t size() const { return header().tick_count; }
+        std::size_t block_count() const { return blocks_.size(); }
+        const TickColumns& block(std::size_t i) const { return blocks_[i]; }
+
+        // file-local symbol id -> name / registry id
+        std::string_view symbol_name(std::uint32_t file_id) const { return names_.at(file_id); }
+        SymbolId symbol_id(std::uint32_t file_id) const { return ids_.at(file_id); }
+
+        FlatTick flat_at(std::size_t block, std::size_t row) const {
+            const TickColumns& c = blocks_[block];
+            FlatTick t{};
+            t.price = c.price[row];
+            t.volume = c.volume[row];
+            t.bid = c.bid[row];
+            t.ask = c.ask[row];
+            t.unix_ts_ns = c.unix_ts_ns[row];
+            t.mono_ts_ns = c.mono_ts_ns[row];
+            t.symbol_id = ids_[c.symbol[row]];
+            t.sequence = c.sequence[row];
+            return t;
+        }
+
+        Tick tick_at(std::size_t block, std::size_t row) const {
+            const TickColumns& c = blocks_[block];
+            Tick t{};
+            t.symbol = std::string(names_[c.symbol[row]]);
+            t.price = c.price[row];
+            t.volume = c.volume[row];
+            t.bid = c.bid[row];
+            t.ask = c.ask[row];
+            t.unix_ts_ns = c.unix_ts_ns[row];
+            t.mono_ts_ns = c.mono_ts_ns[row];
+            t.sequence = c.sequence[row];
+            return t;
+        }
+
+    private:
+        const recording::FileHeader& header() const {
+            return *reinterpret_cast<const recording::FileHeader*>(base_);
+        }
+
+        template <typename C>
+        std::span<const C> column(std::size_t& offset, std::size_t count) const {
+            const auto* p = reinterpret_cast<const C*>(base_ + offset);
+            offset += recording::padded(count * sizeof(C));
+            return {p, count};
+        }
+
+        void index(SymbolRegistry& registry) {
+            const auto& h = header();
+            if (std::memcmp(h.magic, recording::magic, sizeof(h.magic)) != 0) throw std::runtime_error("TickFile: bad magic");
+            if (h.version != recording::version) throw std::runtime_error("TickFile: unsupported version");
+            if (h.symbol_table_offset > size_) throw std::runtime_error("TickFile: corrupt header");
+
+            std::size_t offset = sizeof(recording::FileHeader);
+            std::uint64_t rows = 0;
+            blocks_.reserve(h.block_count);
+            for (std::uint64_t b = 0; b < h.block_count; ++b) {
+                if (offset + sizeof(recording::BlockHeader) > h.symbol_table_offset) throw std::runtime_error("TickFile: corrupt block");
+                const auto& bh = *reinterpret_cast<const recording::BlockHeader*>(base_ + offset);
+                if (bh.bytes != recording::block_bytes(bh.count) || offset + bh.bytes > h.symbol_table_offset) {
+                    throw std::runtime_error("TickFile: corrupt block");
+                }
+                std::size_t col = offset + sizeof(recording::BlockHeader);
+                TickColumns c{};
+                c.count = bh.count;
+                c.price = column<double>(col, bh.count);
+                c.volume = column<double>(col, bh.count);
+                c.bid = column<double>(col, bh.count);
+                c.ask = column<double>(col, bh.count);
+                c.unix_ts_ns = column<std::uint64_t>(col, bh.count);
+                c.mono_ts_ns = column<std::uint64_t>(col, bh.count);
+                c.symbol = column<std::uint32_t>(col, bh.count);
+                c.sequence = column<std::uint32_t>(col, bh.count);
+                blocks_.push_back(c);
+                offset += bh.bytes;
+                rows += bh.count;
+            }
+            if (rows != h.tick_count) throw std::runtime_error("TickFile: tick_count does not match the blocks");
+
+            std::size_t pos = h.symbol_table_offset;
+            for (std::uint32_t i = 0; i < h.symbol_count; ++i) {
+                std::uint32_t len;
+                if (pos + sizeof(len) > size_) throw std::runtime_error("TickFile: corrupt symbol table");
+                std::memcpy(&len, base_ + pos, sizeof(len));
+                pos += sizeof(len);
+                if (pos + len > size_) throw std::runtime_error("TickFile: corrupt symbol table");
+                names_.emplace_back(reinterpret_cast<const char*>(base_ + pos), len);
+                ids_.push_back(registry.intern(names_.back()));
+                pos += len;
+            }
+
+            // flat_at/tick_at index the symbol table unchecked
+            for (const TickColumns& c : blocks_) {
+                for (const std::uint32_t s : c.symbol) {
+                    if (s >= h.symbol_count) throw std::runtime_error("TickFile: symbol index out of range");
+                }
+            }
+        }
+
+        const std::byte* base_{nullptr};
+        std::size_t size_{0};
+        std::vector<TickColumns> blocks_;
+        std::vector<std::string_view> names_; // view into the mapping
+        std::vector<SymbolId> ids_;
+    };
+
+    struct ReplayOptions {
+        double speed = 1.0;                         // 1 => recorded pace, N => N x faster, 0 => max speed
+        bool restamp = false;                       // rewrite mono_ts_ns to the emission time
+        const std::atomic<bool>* running = nullptr; // optional cancellation
+    };
+
+    /// Replays a recording into a ring buffer (T = Tick or FlatTick), preserving the
+    /// recorded mono_ts_ns spacing scaled by 1/speed. Blocks while the ring is full.
+    /// Returns the number of ticks pushed.
+    template <typename T>
+    std::size_t replay(const TickFile& file, RingBuffer<T>& out, const ReplayOptions& options = {}) {
+        static_assert(std::is_same_v<T, Tick> || std::is_same_v<T, FlatTick>);
+        using Clock = std::chrono::steady_clock;
+        constexpr auto spin_window = std::chrono::microseconds(100);
+
+        const auto keep_going = [&] { return options.running == nullptr || options.running->load(std::memory_order_relaxed); };
+        const auto start = Clock::now();
+        const bool paced = options.speed > 0.0;
+        std::uint64_t origin = 0;
+        bool have_origin = false;
+        std::size_t pushed = 0;
+
+        for (std::size_t b = 0; b < file.block_count(); ++b) {
+            const TickColumns& c = file.block(b);
+            for (std::size_t r = 0; r < c.count; ++r) {
+                if (!keep_going()) return pushed;
+                if (paced) {
+                    if (!have_origin) { origin = c.mono_ts_ns[r]; have_origin = true; }
+                    const double offset_ns = static_cast<double>(c.mono_ts_ns[r] - std::min(origin, c.mono_ts_ns[r])) / options.speed;
+                    const auto due = start + std::chrono::nanoseconds(static_cast<std::int64_t>(offset_ns));
+                    if (due - Clock::now() > spin_window) std::this_thread::sleep_until(due - spin_window);
+                    while (Clock::now() < due) detail::cpu_relax();
+                }
+
+                T tick;
+                if constexpr (std::is_same_v<T, Tick>) tick = file.tick_at(b, r);
+                else tick = file.flat_at(b, r);
+                if (options.restamp) {
+                    tick.mono_ts_ns = static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+                }
+                while (!out.try_push(tick)) {
+                    if (!keep_going()) return pushed;
+                    std::this_thread::yield();
+                }
+                ++pushed;
+            }
+        }
+        return pushed;
+    }
+
+} // namespace tickstream
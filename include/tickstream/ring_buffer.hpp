@@ -1,56 +1,203 @@
-// include/tickstream/ring_bufffer.hpp
+// include/tickstream/ring_buffer.hpp
 
 #pragma once
 
-#include <atomic>    // dor thread-safe sequence counter
-#include <vector>    // buffer for batch processing
+#include <algorithm> // std::copy, std::min
+#include <array>
+#include <atomic>    // for thread-safe head/tail sequences
+#include <bit>       // std::bit_ceil
 #include <cstddef>   // for std::size_t (portable size type)
+#include <cstdint>
+#include <cstring>   // std::memcpy
+#include <memory>
+#include <span>      // views for batch and in-place APIs
+#include <stdexcept>
+#include <type_traits>
+#include <utility>   // std::move
+#include <vector>    // slot storage
+
+#include "detail/cache_line.hpp"
+#include "detail/cpu_relax.hpp"
 
 namespace tickstream
 {
-    /// SPSC ring buffer concept for decoupled producer/consumer.
+    /// Bounded single-producer/single-consumer ring buffer.
+    ///
+    /// head/tail are monotonically increasing sequences, each on its own cache line
+    /// together with the owning side's cached copy of the opposite sequence, so the
+    /// shared lines are only touched when the cached view says full/empty.
+    /// Capacity is rounded up to a power of two and slots are addressed by masking.
+    ///
+    /// An overwritable ring additionally lets the producer evict the oldest element
+    /// (push_overwrite), so producer and consumer may touch the same slot at once.
+    /// Its slots are seqlocks whose payload is stored as relaxed atomic words (as in
+    /// ConflatingBuffer); the consumer copies elements out, then claims them with a
+    /// CAS on head and retries if a copy was torn or the producer evicted them
+    /// meanwhile. T must be trivially copyable, and only try_push/try_push_n/
+    /// push_overwrite and try_pop/try_pop_n may be used (the in-place
+    /// claim/peek APIs return nothing).
     template <typename T>
     class RingBuffer {
     public:
-        explicit RingBuffer(std::size_t capacity) 
-            : buffer_(capacity)
-            , capacity_(capacity)
-            , head_(0)
-            , tail_(0) {}
+        explicit RingBuffer(std::size_t capacity, bool overwritable = false)
+            : capacity_(std::bit_ceil(std::max<std::size_t>(capacity, 1)))
+            , mask_(capacity_ - 1)
+            , overwritable_(overwritable)
+            , buffer_(overwritable ? 0 : capacity_) {
+            if (overwritable) {
+                if constexpr (std::is_trivially_copyable_v<T>) slots_ = std::make_unique<Slot[]>(capacity_);
+                else throw std::invalid_argument("RingBuffer: overwritable needs a trivially copyable T");
+            }
+        }
 
         ~RingBuffer() = default;
 
-        // non-blocking, lock-free friendly
-        bool try_push(const T &item) {
-            if (size_.load(std::memory_order_acquire) >= capacity_) {
-                return false; // Buffer is full
-            }
-            
-            buffer_[tail_] = item;
-            tail_ = (tail_ + 1) % capacity_;
-            size_.fetch_add(1, std::memory_order_release);
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        // ---------------- producer side ----------------
+
+        // non-blocking, lock-free
+        bool try_push(const T& item) {
+            if (overwritable_) return try_push_n(std::span<const T>(&item, 1)) == 1;
+            T* slot = try_claim();
+            if (slot == nullptr) return false; // Buffer is full
+            *slot = item;
+            commit();
             return true;
-        }; 
+        }
 
-        bool try_pop(T& item) {
-            if (size_.load(std::memory_order_acquire) == 0) {
-                return false; // Buffer is empty
+        bool try_push(T&& item) {
+            if (overwritable_) return try_push_n(std::span<const T>(&item, 1)) == 1;
+            T* slot = try_claim();
+            if (slot == nullptr) return false; // Buffer is full
+            *slot = std::move(item);
+            commit();
+            return true;
+        }
+
+        // push up to items.size() elements, returns how many were accepted
+        std::size_t try_push_n(std::span<const T> items) {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            const std::size_t n = std::min(items.size(), free_slots(tail, items.size()));
+            if (n == 0) return 0;
+
+            if (overwritable_) {
+                for (std::size_t i = 0; i < n; ++i) store_slot((tail + i) & mask_, items[i]);
+                tail_.store(tail + n, std::memory_order_release);
+                return n;
+            }
+            const std::size_t first = std::min(n, capacity_ - (tail & mask_));
+            std::copy(items.begin(), items.begin() + first, buffer_.begin() + (tail & mask_));
+            std::copy(items.begin() + first, items.begin() + n, buffer_.begin());
+            tail_.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        // push, evicting the oldest element if full; returns false if one was evicted.
+        // Overwritable rings only.
+        bool push_overwrite(const T& item) {
+            static_assert(std::is_trivially_copyable_v<T>, "push_overwrite needs a trivially copyable T");
+            if (!overwritable_) throw std::logic_error("RingBuffer: push_overwrite on a non-overwritable ring");
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            bool evicted = false;
+            if (free_slots(tail, 1) == 0) {
+                // steal the oldest slot; if the CAS fails the consumer just freed it
+                std::size_t oldest = tail - capacity_;
+                evicted = head_.compare_exchange_strong(oldest, oldest + 1, std::memory_order_acq_rel);
+                head_cache_ = head_.load(std::memory_order_acquire);
             }
-            
-            item = buffer_[head_];
-            head_ = (head_ + 1) % capacity_;
-            size_.fetch_sub(1, std::memory_order_release);
+            store_slot(tail & mask_, item);
+            tail_.store(tail + 1, std::memory_order_release);
+            return !evicted;
+        }
+
+        bool overwritable() const { return overwritable_; }
+
+        // in-place write: claim the next slot, construct into it, then commit()
+        T* try_claim() {
+            if (overwritable_) return nullptr;
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (free_slots(tail, 1) == 0) return nullptr;
+            return &buffer_[tail & mask_];
+        }
+
+        // contiguous run of up to max_items writable slots (stops at the wrap point)
+        std::span<T> try_claim_n(std::size_t max_items) {
+            if (overwritable_) return {};
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            const std::size_t n = std::min({max_items,
+                                            free_slots(tail, max_items),
+                                            capacity_ - (tail & mask_)});
+            return {buffer_.data() + (tail & mask_), n};
+        }
+
+        // publish n previously claimed slots
+        void commit(std::size_t n = 1) {
+            tail_.store(tail_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        // ---------------- consumer side ----------------
+
+        bool try_pop(T& item) {
+            if (overwritable_) return pop_contended(std::span<T>(&item, 1)) == 1;
+            T* slot = try_peek();
+            if (slot == nullptr) return false; // Buffer is empty
+            item = std::move(*slot);
+            release();
             return true;
         }
 
-        // total capacity of the buffer
+        // pop up to out.size() elements, returns how many were written
+        std::size_t try_pop_n(std::span<T> out) {
+            if (overwritable_) return pop_contended(out);
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            const std::size_t n = std::min(out.size(), used_slots(head, out.size()));
+            if (n == 0) return 0;
+
+            const std::size_t first = std::min(n, capacity_ - (head & mask_));
+            auto src = buffer_.begin() + (head & mask_);
+            std::move(src, src + first, out.begin());
+            std::move(buffer_.begin(), buffer_.begin() + (n - first), out.begin() + first);
+            head_.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+        // in-place read: the slot stays owned by the consumer until release()
+        T* try_peek() {
+            if (overwritable_) return nullptr;
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (used_slots(head, 1) == 0) return nullptr;
+            return &buffer_[head & mask_];
+        }
+
+        // contiguous run of up to max_items readable slots (stops at the wrap point)
+        std::span<T> try_peek_n(std::size_t max_items) {
+            if (overwritable_) return {};
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            const std::size_t n = std::min({max_items,
+                                            used_slots(head, max_items),
+                                            capacity_ - (head & mask_)});
+            return {buffer_.data() + (head & mask_), n};
+        }
+
+        // hand n previously peeked slots back to the producer
+        void release(std::size_t n = 1) {
+            head_.store(head_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        // ---------------- observers ----------------
+
+        // total capacity of the buffer (power of two)
         std::size_t capacity() const {
             return capacity_;
-        };
+        }
 
-        // current size of the buffer
+        // current size of the buffer; exact only when called from producer or consumer
         std::size_t size() const {
-            return size_.load(std::memory_order_relaxed);
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            return std::min(tail - head, capacity_);
         }
 
         // utility to check if buffer is empty
@@ -63,21 +210,106 @@ namespace tickstream
             return size() == capacity_;
         }
 
-        // utility to clear the buffer
+        // utility to clear the buffer (consumer side: discards everything published so far)
         void clear() {
-            head_ = 0;
-            tail_ = 0;
-            size_.store(0, std::memory_order_release);
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            tail_cache_ = tail;
+            head_.store(tail, std::memory_order_release);
         }
 
-
     private:
-        std::vector<T> buffer_;
-        const std::size_t capacity_;
-        std::size_t head_; // read position
-        std::size_t tail_; // write position
-        std::atomic<std::size_t> size_; // current size
+        // overwritable storage: the producer may rewrite a slot the consumer is copying
+        struct Slot {
+            static constexpr std::size_t words = std::is_trivially_copyable_v<T> ? (sizeof(T) + 7) / 8 : 1;
+            std::atomic<std::uint64_t> seq{0};        // odd while the producer writes
+            std::array<std::atomic<std::uint64_t>, words> data{};
+        };
+
+        // producer (single writer): seqlock-protected store of one element
+        void store_slot(std::size_t index, const T& item) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                Slot& s = slots_[index];
+                const std::uint64_t seq = s.seq.load(std::memory_order_relaxed);
+                s.seq.store(seq + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release); // odd sequence before the data
+
+                std::uint64_t words[Slot::words]{};
+                std::memcpy(words, &item, sizeof(T));
+                for (std::size_t w = 0; w < Slot::words; ++w) s.data[w].store(words[w], std::memory_order_relaxed);
+                s.seq.store(seq + 2, std::memory_order_release);
+            }
+        }
+
+        // consumer: consistent copy of one element, false if the producer was writing it
+        bool load_slot(std::size_t index, T& out) const {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                const Slot& s = slots_[index];
+                const std::uint64_t before = s.seq.load(std::memory_order_acquire);
+                if (before & 1) return false;
+                std::uint64_t words[Slot::words];
+                for (std::size_t w = 0; w < Slot::words; ++w) words[w] = s.data[w].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) != before) return false;
+                std::memcpy(&out, words, sizeof(T));
+                return true;
+            } else {
+                return false;
+            }
+        }
+
+        // consumer path for overwritable rings: copy first, then claim with a CAS; a
+        // producer that evicted any of the copied elements has moved head, so the CAS
+        // fails and the copies are discarded
+        std::size_t pop_contended(std::span<T> out) {
+            for (;;) {
+                std::size_t head = head_.load(std::memory_order_acquire);
+                const std::size_t tail = tail_.load(std::memory_order_acquire);
+                const std::size_t n = std::min({out.size(), tail - head, capacity_});
+                if (n == 0) return 0;
+                bool torn = false;
+                for (std::size_t i = 0; i < n && !torn; ++i) torn = !load_slot((head + i) & mask_, out[i]);
+                if (torn) {
+                    detail::cpu_relax();
+                    continue;
+                }
+                if (head_.compare_exchange_strong(head, head + n, std::memory_order_acq_rel)) return n;
+            }
+        }
+
+        // producer: free slots, refreshing the cached head only if the cached view is short
+        std::size_t free_slots(std::size_t tail, std::size_t wanted) {
+            std::size_t free = capacity_ - (tail - head_cache_);
+            if (free < wanted) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                free = capacity_ - (tail - head_cache_);
+            }
+            return free;
+        }
+
+        // consumer: readable slots, refreshing the cached tail only if the cached view is short
+        std::size_t used_slots(std::size_t head, std::size_t wanted) {
+            std::size_t used = tail_cache_ - head;
+            if (used < wanted) {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                used = tail_cache_ - head;
+            }
+            return used;
+        }
+
+        // producer-owned line
+        alignas(detail::cache_line_size) std::atomic<std::size_t> tail_{0}; // write sequence
+        std::size_t head_cache_{0};                                          // last seen head
+
+        // consumer-owned line
+        alignas(detail::cache_line_size) std::atomic<std::size_t> head_{0}; // read sequence
+        std::size_t tail_cache_{0};                                          // last seen tail
 
+        // read-only after construction
+        alignas(detail::cache_line_size) const std::size_t capacity_;
+        const std::size_t mask_;
+        const bool overwritable_;
+        std::vector<T> buffer_;                  // plain rings
+        std::unique_ptr<Slot[]> slots_;          // overwritable rings
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,234 @@
+// include/tickstream/scheduler.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "detail/cpu_relax.hpp"
+#include "detail/rng.h"
+
+namespace tickstream {
+
+    enum class PacingMode {
+        Sleep,  // block on the OS until the deadline (cheapest, ~50-100us late)
+        Spin,   // busy-wait to the deadline (most precise, burns the core)
+        Hybrid  // sleep until spin_threshold before the deadline, then spin
+    };
+
+    /// Deadline-driven scheduler for periodic tasks.
+    ///
+    /// Tasks live in a min-heap keyed on their next deadline, sharded over a few
+    /// worker threads (task id % threads). Deadlines advance on a nominal grid
+    /// (nominal += interval), so callback cost never accumulates into drift.
+    /// Jitter is modeled: each emission is offset from its nominal time by a
+    /// uniform draw in [0, jitter) from a per-task counter-based RNG stream.
+    class Scheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TaskId = std::uint64_t;
+
+        struct Options {
+            std::size_t threads = 1;
+            PacingMode mode = PacingMode::Hybrid;
+            std::chrono::nanoseconds spin_threshold{std::chrono::microseconds(100)};
+            std::uint64_t seed = 0; // jitter stream seed, 0 => random_device
+        };
+
+        Scheduler() : Scheduler(Options{}) {}
+
+        explicit Scheduler(Options options)
+            : options_(options)
+            , rng_(options.seed) {
+            const std::size_t n = std::max<std::size_t>(options_.threads, 1);
+            for (std::size_t i = 0; i < n; ++i) shards_.push_back(std::make_unique<Shard>());
+        }
+
+        ~Scheduler() { stop(); }
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // helper: period for a rate in Hz; the rate must be finite, positive and high
+        // enough for the period to fit in int64 nanoseconds
+        static std::chrono::nanoseconds interval_for(double rate_hz) {
+            if (!std::isfinite(rate_hz) || rate_hz <= 0.0) throw std::invalid_argument("Scheduler: rate_hz must be finite and > 0");
+            const double period_ns = 1e9 / rate_hz;
+            if (!(period_ns < 0x1p63)) throw std::invalid_argument("Scheduler: rate_hz too small, period overflows");
+            return std::chrono::nanoseconds(static_cast<std::int64_t>(period_ns));
+        }
+
+        // register a periodic task; first run is one interval from now
+        TaskId add(std::function<void()> fn, std::chrono::nanoseconds interval,
+                   std::chrono::nanoseconds jitter = std::chrono::nanoseconds::zero()) {
+            const TaskId id = next_id_.fetch_add(1, std::memory_order_relaxed);
+            auto task = std::make_shared<Task>();
+            task->fn = std::move(fn);
+            task->interval = std::max(interval, std::chrono::nanoseconds(1));
+            task->jitter = jitter;
+            task->rng = rng_.substream(id);
+            task->nominal = Clock::now() + task->interval;
+
+            Shard& shard = shard_for(id);
+            {
+                std::lock_guard lock(shard.mutex);
+                shard.tasks.emplace(id, task);
+                push(shard, {task->nominal + sample_jitter(*task), id});
+            }
+            shard.cv.notify_all(); // the cv is shared with remove() waiters
+            return id;
+        }
+
+        // unregister a task; blocks until an in-flight run of it has returned
+        // (unless called from inside that task)
+        void remove(TaskId id) {
+            Shard& shard = shard_for(id);
+            std::unique_lock lock(shard.mutex);
+            auto it = shard.tasks.find(id);
+            if (it == shard.tasks.end()) return;
+            auto task = it->second;
+            shard.tasks.erase(it); // heap entry is discarded lazily when it surfaces
+            if (std::this_thread::get_id() != shard.thread_id.load(std::memory_order_acquire)) {
+                shard.cv.wait(lock, [&] { return !task->running; });
+            }
+        }
+
+        void start() {
+            if (running_.exchange(true)) return;
+            for (auto& shard : shards_) {
+                shard->thread = std::thread([this, s = shard.get()] { loop(*s); });
+            }
+        }
+
+        void stop() {
+            if (!running_.exchange(false)) return;
+            for (auto& shard : shards_) {
+                { std::lock_guard lock(shard->mutex); }
+                shard->cv.notify_all();
+                if (shard->thread.joinable()) shard->thread.join();
+                shard->thread_id.store(std::thread::id{}, std::memory_order_release);
+            }
+        }
+
+        bool running() const { return running_.load(std::memory_order_relaxed); }
+
+        std::size_t size() const {
+            std::size_t n = 0;
+            for (const auto& shard : shards_) {
+                std::lock_guard lock(shard->mutex);
+                n += shard->tasks.size();
+            }
+            return n;
+        }
+
+    private:
+        struct Task {
+            std::function<void()> fn;
+            std::chrono::nanoseconds interval;
+            std::chrono::nanoseconds jitter;
+            detail::RNG rng{1};
+            Clock::time_point nominal;
+            bool running = false;
+        };
+
+        struct Entry {
+            Clock::time_point due;
+            TaskId id;
+            bool operator>(const Entry& o) const { return due > o.due; }
+        };
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::condition_variable cv;
+            std::vector<Entry> heap; // min-heap on due
+            std::unordered_map<TaskId, std::shared_ptr<Task>> tasks;
+            std::thread thread;
+            std::atomic<std::thread::id> thread_id{}; // set by the worker itself, read by remove()
+        };
+
+        Shard& shard_for(TaskId id) { return *shards_[id % shards_.size()]; }
+
+        static void push(Shard& s, Entry e) {
+            s.heap.push_back(e);
+            std::push_heap(s.heap.begin(), s.heap.end(), std::greater<>{});
+        }
+
+        static Entry pop(Shard& s) {
+            std::pop_heap(s.heap.begin(), s.heap.end(), std::greater<>{});
+            Entry e = s.heap.back();
+            s.heap.pop_back();
+            return e;
+        }
+
+        static std::chrono::nanoseconds sample_jitter(Task& t) {
+            if (t.jitter <= std::chrono::nanoseconds::zero()) return std::chrono::nanoseconds::zero();
+            return std::chrono::nanoseconds(static_cast<std::int64_t>(t.rng.uniform(0.0, 1.0) * t.jitter.count()));
+        }
+
+        // wait until `due` or until woken (new task / stop); returns with the lock held
+        void wait_until(Shard& s, std::unique_lock<std::mutex>& lock, Clock::time_point due) {
+            const bool spin = options_.mode == PacingMode::Spin ||
+                              (options_.mode == PacingMode::Hybrid && due - Clock::now() <= options_.spin_threshold);
+            if (!spin) {
+                const auto wake = options_.mode == PacingMode::Hybrid ? due - options_.spin_threshold : due;
+                s.cv.wait_until(lock, wake);
+                return;
+            }
+            lock.unlock();
+            while (Clock::now() < due && running()) detail::cpu_relax();
+            lock.lock();
+        }
+
+        void loop(Shard& s) {
+            s.thread_id.store(std::this_thread::get_id(), std::memory_order_release);
+            std::unique_lock lock(s.mutex);
+            while (running()) {
+                if (s.heap.empty()) {
+                    s.cv.wait(lock);
+                    continue;
+                }
+                const Entry top = s.heap.front();
+                auto it = s.tasks.find(top.id);
+                if (it == s.tasks.end()) { // removed
+                    pop(s);
+                    continue;
+                }
+                if (Clock::now() < top.due) {
+                    wait_until(s, lock, top.due); // re-evaluate: the heap may have changed
+                    continue;
+                }
+
+                pop(s);
+                auto task = it->second;
+                task->running = true;
+                lock.unlock();
+                task->fn();
+                lock.lock();
+                task->running = false;
+
+                // late tasks run back-to-back until they are back on their nominal grid
+                task->nominal += task->interval;
+                if (s.tasks.contains(top.id)) push(s, {task->nominal + sample_jitter(*task), top.id});
+                s.cv.notify_all(); // wake remove() waiters
+            }
+        }
+
+        Options options_;
+        detail::RNG rng_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+        std::atomic<TaskId> next_id_{0};
+        std::atomic<bool> running_{false};
+    };
+
+} // namespace tickstream
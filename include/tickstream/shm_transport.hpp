@@ -0,0 +1,496 @@
+// include/tickstream/shm_transport.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "detail/cache_line.hpp"
+#include "detail/cpu_relax.hpp"
+#include "wait_strategy.hpp"
+
+namespace tickstream {
+
+    /* Cross-process broadcast ring in a named POSIX shared-memory segment.
+     *
+     * Segment layout (all offsets cache-line aligned):
+     *   ShmHeader | ShmSubscriberSlot[max_subscribers] | T[capacity]
+     *
+     * One ShmPublisher per segment writes elements and advances the cursor; every
+     * attached ShmSubscriber reads all of them at its own pace (like MulticastRing)
+     * and the publisher is gated on the slowest live subscriber.
+     *
+     * Attach handshake: the publisher initializes a fresh segment and stores the
+     * magic last; a subscriber waits for the magic, checks version, element size
+     * and capacity, claims a free slot and starts at the current cursor. A
+     * publisher that restarts on a compatible segment keeps the cursor and bumps
+     * the epoch, so attached subscribers carry on (and count a reconnect).
+     *
+     * A slot belongs to the process whose pid it holds (0 => free): subscribers
+     * claim it with a CAS on pid, so the owner is recorded before the slot is
+     * used, and release it by clearing state, then pid. The publisher reclaims
+     * slots whose owner died, whether it got as far as active or not.
+     *
+     * Blocking subscribers sleep on a process-shared futex in the header;
+     * std::atomic::wait cannot be used because it may use private futexes. */
+
+    namespace detail {
+        inline long futex(std::atomic<std::uint32_t>& word, int op, std::uint32_t value, const timespec* timeout) {
+            static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+            return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, value, timeout, nullptr, 0);
+        }
+
+        inline std::string shm_path(const std::string& name) {
+            return name.empty() || name.front() != '/' ? "/" + name : name;
+        }
+    } // namespace detail
+
+    inline constexpr std::uint64_t shm_magic = 0x314D485354534B54ull; // "TKSTSHM1" little-endian
+    inline constexpr std::uint32_t shm_version = 2;
+
+    struct ShmOptions {
+        std::size_t capacity = 65536;       // elements, power of two
+        std::size_t max_subscribers = 16;
+        bool unlink_on_close = true;        // false keeps the segment for a restarted publisher
+    };
+
+    struct alignas(detail::cache_line_size) ShmHeader {
+        std::atomic<std::uint64_t> magic;   // written last by the initializing publisher
+        std::uint32_t version;
+        std::uint32_t elem_size;
+        std::uint64_t capacity;
+        std::uint32_t max_subscribers;
+        std::atomic<std::int32_t> publisher_pid; // 0 => no publisher attached
+        std::atomic<std::uint64_t> epoch;   // +1 per publisher (re)attach
+
+        alignas(detail::cache_line_size) std::atomic<std::uint64_t> cursor; // elements published
+
+        alignas(detail::cache_line_size) std::atomic<std::uint32_t> futex;  // bumped on publish
+        std::atomic<std::uint32_t> waiters; // blocked subscribers
+    };
+
+    struct alignas(detail::cache_line_size) ShmSubscriberSlot {
+        static constexpr std::uint32_t free = 0, claimed = 1, active = 2;
+
+        std::atomic<std::uint64_t> next;    // next element to read
+        std::atomic<std::uint32_t> state;   // gating: only active slots hold the publisher back
+        std::atomic<std::int32_t> pid;      // owner; claimed by CAS from 0
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+                  "shm transport needs address-free atomics");
+
+    namespace detail {
+        // maps a segment; owns the fd-less mapping
+        class ShmMapping {
+        public:
+            ShmMapping() = default;
+            ShmMapping(void* base, std::size_t size) : base_(base), size_(size) {}
+            ~ShmMapping() { reset(); }
+
+            ShmMapping(ShmMapping&& other) noexcept : base_(std::exchange(other.base_, nullptr)), size_(other.size_) {}
+            ShmMapping& operator=(ShmMapping&& other) noexcept {
+                if (this != &other) {
+                    reset();
+                    base_ = std::exchange(other.base_, nullptr);
+                    size_ = other.size_;
+                }
+                return *this;
+            }
+
+            void reset() {
+                if (base_) ::munmap(base_, size_);
+                base_ = nullptr;
+            }
+
+            std::byte* data() const { return static_cast<std::byte*>(base_); }
+            explicit operator bool() const { return base_ != nullptr; }
+
+        private:
+            void* base_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
+        inline std::size_t shm_slots_offset() { return sizeof(ShmHeader); }
+
+        inline std::size_t shm_data_offset(std::size_t max_subscribers) {
+            return shm_slots_offset() + max_subscribers * sizeof(ShmSubscriberSlot);
+        }
+
+        inline std::size_t shm_size(std::size_t max_subscribers, std::size_t capacity, std::size_t elem_size) {
+            return shm_data_offset(max_subscribers) + capacity * elem_size;
+        }
+
+        inline bool process_alive(std::int32_t pid) {
+            return pid > 0 && (::kill(pid, 0) == 0 || errno != ESRCH);
+        }
+
+        inline ShmMapping map_fd(int fd, std::size_t size, const char* who) {
+            void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (map == MAP_FAILED) throw std::runtime_error(std::string(who) + ": mmap failed");
+            return ShmMapping(map, size);
+        }
+    } // namespace detail
+
+    /// Producer end of a shared-memory feed. Single writer per segment.
+    template<typename T>
+    class ShmPublisher {
+        static_assert(std::is_trivially_copyable_v<T>, "ShmPublisher: T must be trivially copyable");
+
+    public:
+        explicit ShmPublisher(const std::string& name, ShmOptions options = {})
+            : path_(detail::shm_path(name)), options_(options) {
+            if (!std::has_single_bit(options.capacity)) throw std::invalid_argument("ShmPublisher: capacity must be a power of two");
+            if (options.max_subscribers == 0) throw std::invalid_argument("ShmPublisher: max_subscribers must be > 0");
+
+            const std::size_t size = detail::shm_size(options.max_subscribers, options.capacity, sizeof(T));
+            int fd = ::shm_open(path_.c_str(), O_RDWR | O_CREAT, 0600);
+            if (fd < 0) throw std::runtime_error("ShmPublisher: shm_open failed for " + path_);
+
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("ShmPublisher: fstat failed for " + path_);
+            }
+            if (const auto existing = static_cast<std::size_t>(st.st_size); existing >= sizeof(ShmHeader)) {
+                // whatever its layout, never take over a segment another live publisher owns
+                map_ = detail::map_fd(fd, existing, "ShmPublisher");
+                if (header().magic.load(std::memory_order_acquire) == shm_magic) {
+                    if (const auto pid = header().publisher_pid.load(std::memory_order_relaxed);
+                        pid != ::getpid() && detail::process_alive(pid)) {
+                        map_.reset();
+                        ::close(fd);
+                        throw std::runtime_error("ShmPublisher: " + path_ + " already has a live publisher");
+                    }
+                }
+                if (existing != size || !compatible()) map_.reset(); // different layout: start over
+            }
+            if (!map_) {
+                // fresh or incompatible segment: replace it so stale subscribers cannot misread it
+                ::close(fd);
+                ::shm_unlink(path_.c_str());
+                fd = ::shm_open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+                if (fd < 0) throw std::runtime_error("ShmPublisher: shm_open failed for " + path_);
+                if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                    ::close(fd);
+                    throw std::runtime_error("ShmPublisher: ftruncate failed for " + path_);
+                }
+                map_ = detail::map_fd(fd, size, "ShmPublisher");
+                initialize();
+            }
+            ::close(fd);
+
+            header().publisher_pid.store(static_cast<std::int32_t>(::getpid()), std::memory_order_relaxed);
+            header().epoch.fetch_add(1, std::memory_order_seq_cst);
+            cursor_ = header().cursor.load(std::memory_order_relaxed);
+        }
+
+        ~ShmPublisher() {
+            header().publisher_pid.store(0, std::memory_order_seq_cst);
+            wake();
+            map_.reset();
+            if (options_.unlink_on_close) ::shm_unlink(path_.c_str());
+        }
+
+        ShmPublisher(const ShmPublisher&) = delete;
+        ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+        // remove a segment left behind (e.g. by a crashed publisher)
+        static void unlink(const std::string& name) { ::shm_unlink(detail::shm_path(name).c_str()); }
+
+        // false while the slowest live subscriber is a full ring behind
+        bool try_publish(const T& value) {
+            if (cursor_ - gate_ >= options_.capacity) {
+                gate_ = min_subscriber_next();
+                if (cursor_ - gate_ >= options_.capacity) return false;
+            }
+            write(value);
+            return true;
+        }
+
+        // waits for room, reclaiming slots of subscriber processes that exited
+        void publish(const T& value) {
+            for (std::uint32_t spins = 0; !try_publish(value); ++spins) {
+                if ((spins & 1023) == 1023) reap();
+                if (spins < 256) detail::cpu_relax();
+                else std::this_thread::yield();
+            }
+        }
+
+        std::uint64_t cursor() const { return cursor_; }
+        std::uint64_t epoch() const { return header().epoch.load(std::memory_order_relaxed); }
+        std::size_t capacity() const { return options_.capacity; }
+
+        std::size_t subscribers() const {
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < options_.max_subscribers; ++i) {
+                n += slot(i).state.load(std::memory_order_relaxed) == ShmSubscriberSlot::active;
+            }
+            return n;
+        }
+
+        // free the slots of subscribers whose process no longer exists; returns how many.
+        // A slot owned by a dead pid is only ever touched here, never by a subscriber.
+        std::size_t reap() {
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < options_.max_subscribers; ++i) {
+                ShmSubscriberSlot& s = slot(i);
+                std::int32_t owner = s.pid.load(std::memory_order_acquire);
+                if (owner == 0 || detail::process_alive(owner)) continue;
+                s.state.store(ShmSubscriberSlot::free, std::memory_order_seq_cst);
+                n += s.pid.compare_exchange_strong(owner, 0, std::memory_order_acq_rel);
+            }
+            return n;
+        }
+
+    private:
+        ShmHeader& header() const { return *reinterpret_cast<ShmHeader*>(map_.data()); }
+
+        ShmSubscriberSlot& slot(std::size_t i) const {
+            return reinterpret_cast<ShmSubscriberSlot*>(map_.data() + detail::shm_slots_offset())[i];
+        }
+
+        T* data() const { return reinterpret_cast<T*>(map_.data() + detail::shm_data_offset(options_.max_subscribers)); }
+
+        bool compatible() const {
+            const ShmHeader& h = header();
+            return h.magic.load(std::memory_order_acquire) == shm_magic && h.version == shm_version
+                   && h.elem_size == sizeof(T) && h.capacity == options_.capacity
+                   && h.max_subscribers == options_.max_subscribers;
+        }
+
+        void initialize() {
+            auto* h = new (map_.data()) ShmHeader{};
+            h->version = shm_version;
+            h->elem_size = static_cast<std::uint32_t>(sizeof(T));
+            h->capacity = options_.capacity;
+            h->max_subscribers = static_cast<std::uint32_t>(options_.max_subscribers);
+            for (std::size_t i = 0; i < options_.max_subscribers; ++i) {
+                new (map_.data() + detail::shm_slots_offset() + i * sizeof(ShmSubscriberSlot)) ShmSubscriberSlot{};
+            }
+            h->magic.store(shm_magic, std::memory_order_release);
+        }
+
+        std::uint64_t min_subscriber_next() const {
+            std::uint64_t gate = cursor_;
+            for (std::size_t i = 0; i < options_.max_subscribers; ++i) {
+                const ShmSubscriberSlot& s = slot(i);
+                if (s.state.load(std::memory_order_seq_cst) != ShmSubscriberSlot::active) continue;
+                gate = std::min(gate, s.next.load(std::memory_order_acquire));
+            }
+            return gate;
+        }
+
+        void write(const T& value) {
+            data()[cursor_ & (options_.capacity - 1)] = value;
+            header().cursor.store(++cursor_, std::memory_order_seq_cst);
+            if (header().waiters.load(std::memory_order_seq_cst) != 0) wake();
+        }
+
+        void wake() {
+            header().futex.fetch_add(1, std::memory_order_seq_cst);
+            detail::futex(header().futex, FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr);
+        }
+
+        std::string path_;
+        ShmOptions options_;
+        detail::ShmMapping map_;
+        std::uint64_t cursor_{0};
+        std::uint64_t gate_{0};   // cached slowest subscriber position
+    };
+
+    /// Consumer end of a shared-memory feed: sees every element published after it attached.
+    template<typename T>
+    class ShmSubscriber {
+        static_assert(std::is_trivially_copyable_v<T>, "ShmSubscriber: T must be trivially copyable");
+
+    public:
+        // attach_timeout: how long to wait for the publisher to create the segment
+        explicit ShmSubscriber(const std::string& name, WaitKind wait = WaitKind::SpinYield,
+                               std::chrono::milliseconds attach_timeout = std::chrono::milliseconds::zero())
+            : path_(detail::shm_path(name)), kind_(wait) {
+            attach(attach_timeout);
+        }
+
+        ~ShmSubscriber() { detach(); }
+
+        ShmSubscriber(const ShmSubscriber&) = delete;
+        ShmSubscriber& operator=(const ShmSubscriber&) = delete;
+
+        // f(const T&) for up to max_items published elements; returns the count
+        template<typename F>
+        std::size_t poll(F&& f, std::size_t max_items = std::numeric_limits<std::size_t>::max()) {
+            check_epoch();
+            const std::uint64_t available = header().cursor.load(std::memory_order_acquire);
+            const std::uint64_t end = available - next_ > max_items ? next_ + max_items : available;
+            const T* ring = data();
+            for (std::uint64_t i = next_; i < end; ++i) f(static_cast<const T&>(ring[i & mask_]));
+            const std::size_t n = static_cast<std::size_t>(end - next_);
+            if (n != 0) {
+                next_ = end;
+                slot().next.store(next_, std::memory_order_release);
+            }
+            return n;
+        }
+
+        // wait (per the WaitKind) until something is published, the publisher
+        // detaches or running is cleared; returns whether data is available
+        bool wait(const std::atomic<bool>& running) {
+            const auto ready = [&] { return header().cursor.load(std::memory_order_acquire) != next_; };
+            for (std::uint32_t i = 0; kind_ == WaitKind::BusySpin || i < spin_limit; ++i) {
+                if (ready()) return true;
+                if (!running.load(std::memory_order_relaxed) || !connected()) return false;
+                detail::cpu_relax();
+            }
+            while (!ready()) {
+                if (!running.load(std::memory_order_relaxed) || !connected()) return false;
+                if (kind_ == WaitKind::SpinYield) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const std::uint32_t seen = header().futex.load(std::memory_order_seq_cst);
+                header().waiters.fetch_add(1, std::memory_order_seq_cst);
+                if (!ready()) {
+                    const timespec timeout{0, 10'000'000}; // re-check running and the publisher
+                    detail::futex(header().futex, FUTEX_WAIT, seen, &timeout);
+                }
+                header().waiters.fetch_sub(1, std::memory_order_seq_cst);
+            }
+            return true;
+        }
+
+        // publisher attached and its process alive
+        bool connected() const {
+            return detail::process_alive(header().publisher_pid.load(std::memory_order_relaxed));
+        }
+
+        // re-run the attach handshake, e.g. after the publisher replaced the segment
+        void reconnect(std::chrono::milliseconds attach_timeout = std::chrono::milliseconds::zero()) {
+            detach();
+            attach(attach_timeout);
+            ++reconnects_;
+        }
+
+        std::uint64_t position() const { return next_; }
+        std::uint64_t lag() const { return header().cursor.load(std::memory_order_relaxed) - next_; }
+        std::uint64_t reconnects() const { return reconnects_; }
+        std::size_t capacity() const { return mask_ + 1; }
+
+    private:
+        static constexpr std::uint32_t spin_limit = 256;
+
+        ShmHeader& header() const { return *reinterpret_cast<ShmHeader*>(map_.data()); }
+
+        ShmSubscriberSlot& slot() const {
+            return reinterpret_cast<ShmSubscriberSlot*>(map_.data() + detail::shm_slots_offset())[slot_];
+        }
+
+        const T* data() const { return reinterpret_cast<const T*>(map_.data() + data_offset_); }
+
+        void attach(std::chrono::milliseconds timeout) {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            for (;;) {
+                if (try_attach()) return;
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    throw std::runtime_error("ShmSubscriber: no publisher segment at " + path_);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        // false while the segment is missing or not initialized yet; throws on a layout
+        // mismatch. Maps, validates and claims into locals: map_ and slot_ are only
+        // replaced once attached, so a throw leaves this subscriber detached.
+        bool try_attach() {
+            const int fd = ::shm_open(path_.c_str(), O_RDWR, 0);
+            if (fd < 0) return false;
+            struct stat st{};
+            if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(ShmHeader)) {
+                ::close(fd);
+                return false;
+            }
+            const auto size = static_cast<std::size_t>(st.st_size);
+            detail::ShmMapping map = detail::map_fd(fd, size, "ShmSubscriber");
+            ::close(fd);
+
+            ShmHeader& h = *reinterpret_cast<ShmHeader*>(map.data());
+            if (h.magic.load(std::memory_order_acquire) != shm_magic) return false;
+            if (h.version != shm_version) throw std::runtime_error("ShmSubscriber: unsupported segment version");
+            if (h.elem_size != sizeof(T)) throw std::runtime_error("ShmSubscriber: element size mismatch");
+            if (!std::has_single_bit(h.capacity) || size != detail::shm_size(h.max_subscribers, h.capacity, sizeof(T))) {
+                throw std::runtime_error("ShmSubscriber: corrupt segment header");
+            }
+
+            // claim a slot, then become visible to the publisher's gating
+            auto* slots = reinterpret_cast<ShmSubscriberSlot*>(map.data() + detail::shm_slots_offset());
+            const auto self = static_cast<std::int32_t>(::getpid());
+            std::size_t index = 0;
+            for (; index < h.max_subscribers; ++index) {
+                std::int32_t expected = 0;
+                if (slots[index].pid.compare_exchange_strong(expected, self, std::memory_order_acq_rel)) break;
+            }
+            if (index == h.max_subscribers) throw std::runtime_error("ShmSubscriber: no free subscriber slot");
+
+            ShmSubscriberSlot& s = slots[index];
+            s.state.store(ShmSubscriberSlot::claimed, std::memory_order_relaxed);
+            s.next.store(h.cursor.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            s.state.store(ShmSubscriberSlot::active, std::memory_order_seq_cst);
+            // a publisher that gated before seeing us only wrote at or after this cursor
+            next_ = h.cursor.load(std::memory_order_seq_cst);
+            s.next.store(next_, std::memory_order_seq_cst);
+            epoch_ = h.epoch.load(std::memory_order_acquire);
+            mask_ = static_cast<std::size_t>(h.capacity - 1);
+            data_offset_ = detail::shm_data_offset(h.max_subscribers);
+            slot_ = index;
+            map_ = std::move(map);
+            return true;
+        }
+
+        void detach() {
+            if (!map_) return;
+            slot().state.store(ShmSubscriberSlot::free, std::memory_order_seq_cst); // stop gating first
+            slot().pid.store(0, std::memory_order_release);                         // then hand the slot back
+            map_.reset();
+        }
+
+        // a publisher restarted on this segment: it kept the cursor, so just note it
+        void check_epoch() {
+            const std::uint64_t epoch = header().epoch.load(std::memory_order_relaxed);
+            if (epoch != epoch_) {
+                epoch_ = epoch;
+                ++reconnects_;
+            }
+        }
+
+        std::string path_;
+        WaitKind kind_;
+        detail::ShmMapping map_;
+        std::size_t slot_{0};
+        std::size_t mask_{0};
+        std::size_t data_offset_{0};
+        std::uint64_t next_{0};
+        std::uint64_t epoch_{0};
+        std::uint64_t reconnects_{0};
+    };
+
+} // namespace tickstream
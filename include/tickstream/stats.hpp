@@ -0,0 +1,144 @@
+// include/tickstream/stats.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/cache_line.hpp"
+
+namespace tickstream {
+
+    /// Counter split over cache-padded per-thread shards; add() touches only the
+    /// calling thread's line, load() sums all shards.
+    class ShardedCounter {
+    public:
+        static constexpr std::size_t shards = 32;
+
+        void add(std::uint64_t n = 1) {
+            cells_[shard_index()].value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        std::uint64_t load() const {
+            std::uint64_t sum = 0;
+            for (const auto& c : cells_) sum += c.value.load(std::memory_order_relaxed);
+            return sum;
+        }
+
+    private:
+        // threads are assigned shards round-robin on first use
+        static std::size_t shard_index() {
+            static std::atomic<std::size_t> next{0};
+            thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % shards;
+            return index;
+        }
+
+        std::array<detail::Padded<std::atomic<std::uint64_t>>, shards> cells_{};
+    };
+
+    /// Running maximum; the CAS only runs when a new maximum is observed.
+    class HighWaterMark {
+    public:
+        void update(std::uint64_t v) {
+            std::uint64_t cur = value_.load(std::memory_order_relaxed);
+            while (v > cur && !value_.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+        }
+
+        std::uint64_t load() const { return value_.load(std::memory_order_relaxed); }
+
+    private:
+        alignas(detail::cache_line_size) std::atomic<std::uint64_t> value_{0};
+    };
+
+    /// HDR-style log-linear histogram of nanosecond values.
+    ///
+    /// Values below 2^sub_bits are exact; above that every power of two is split
+    /// into 2^(sub_bits-1) linear buckets over the full 64-bit range, in a fixed
+    /// 976-bucket array for sub_bits=5. A bucket spans 1/32 (top of an octave) to
+    /// 1/16 (bottom) of its values, so a reported bucket upper bound overstates the
+    /// value by at most 2^(1-sub_bits) = 6.25%.
+    class LatencyHistogram {
+    public:
+        static constexpr unsigned sub_bits = 5;
+        static constexpr std::size_t sub_count = std::size_t{1} << sub_bits;
+        static constexpr std::size_t half_count = sub_count / 2;
+        static constexpr std::size_t bucket_count = sub_count + (64 - sub_bits) * half_count;
+        static constexpr double max_relative_error = 1.0 / half_count; // (upper_bound_of(index_of(v)) - v) / v
+
+        static constexpr std::size_t index_of(std::uint64_t v) {
+            if (v < sub_count) return static_cast<std::size_t>(v);
+            const unsigned msb = static_cast<unsigned>(std::bit_width(v)) - 1;
+            const std::uint64_t top = v >> (msb - sub_bits + 1); // in [half_count, sub_count)
+            return sub_count + (msb - sub_bits) * half_count + static_cast<std::size_t>(top - half_count);
+        }
+
+        // highest value that maps to bucket i
+        static constexpr std::uint64_t upper_bound_of(std::size_t i) {
+            if (i < sub_count) return i;
+            const std::size_t k = (i - sub_count) / half_count;
+            const std::uint64_t top = (i - sub_count) % half_count + half_count;
+            const unsigned shift = static_cast<unsigned>(k) + 1;
+            return ((top + 1) << shift) - 1;
+        }
+
+        void record(std::uint64_t v) {
+            buckets_[index_of(v)].fetch_add(1, std::memory_order_relaxed);
+            max_.update(v);
+        }
+
+        std::uint64_t count() const {
+            std::uint64_t n = 0;
+            for (const auto& b : buckets_) n += b.load(std::memory_order_relaxed);
+            return n;
+        }
+
+        std::uint64_t max() const { return max_.load(); }
+
+        // value at quantile q in [0,1] (bucket upper bound, clamped to the observed max)
+        std::uint64_t percentile(double q) const {
+            const std::uint64_t total = count();
+            if (total == 0) return 0;
+            const auto rank = static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(total - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                seen += buckets_[i].load(std::memory_order_relaxed);
+                if (seen >= rank) return std::min(upper_bound_of(i), max());
+            }
+            return max();
+        }
+
+        void merge(const LatencyHistogram& other) {
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                buckets_[i].fetch_add(other.buckets_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            max_.update(other.max());
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucket_count> buckets_{};
+        HighWaterMark max_;
+    };
+
+    /// Consumer-side instrumentation for one stream: consumed count,
+    /// enqueue-to-dequeue latency (from Tick::mono_ts_ns) and queue depth.
+    struct StreamStats {
+        ShardedCounter consumed;
+        LatencyHistogram latency_ns;
+        HighWaterMark depth_high_water;
+
+        static std::uint64_t now_ns() {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        void record_latency(std::uint64_t mono_ts_ns, std::uint64_t now) {
+            latency_ns.record(now > mono_ts_ns ? now - mono_ts_ns : 0);
+        }
+    };
+
+} // namespace tickstream
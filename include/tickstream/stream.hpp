@@ -2,40 +2,95 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <stdexcept>
 #include <unordered_map>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 // internal includes
+#include "lane_merger.hpp"
 #include "ring_buffer.hpp"
 #include "producer.hpp"
 #include "consumer.hpp"
+#include "params.hpp"
+#include "scheduler.hpp"
+#include "stats.hpp"
 #include "tick.hpp"
+#include "wait_strategy.hpp"
 
 namespace tickstream {
 
-class TickStream {
+// T is the lane element: Tick, or FlatTick for OverflowPolicy::OverwriteOldest (which
+// needs a trivially copyable element and overwritable lanes).
+template<typename T>
+class BasicTickStream {
 public:
-    TickStream(size_t buffer_size = 4096) 
-        : buffer_(buffer_size) {}
+    // All symbols are paced by one Scheduler. Every symbol pushes into its own SPSC
+    // lane of lane_capacity ticks, so any number of scheduler threads is safe; the
+    // consumer reads the lanes back in mono_ts_ns order through merger(). With the
+    // default reorder_window of zero that order is best-effort: a tick still in
+    // flight on an empty lane may surface after a later one (counted in late()).
+    BasicTickStream(size_t lane_capacity = 4096, Scheduler::Options scheduling = {},
+               WaitKind wait = WaitKind::SpinYield,
+               std::chrono::nanoseconds reorder_window = std::chrono::nanoseconds::zero()) 
+        : lane_capacity_(lane_capacity)
+        , merger_(reorder_window)
+        , wait_(wait)
+        , scheduler_(scheduling) {}
+
+    ~BasicTickStream() { stop(); }
     
-    // Add a symbol to stream
+    // Add a symbol to stream (before start())
     template<typename Callback>
     void add_symbol(const std::string& symbol, Callback tick_generator, 
-                    std::chrono::milliseconds interval = std::chrono::milliseconds(100)) {
-        auto producer = std::make_unique<Producer<Tick>>(
-            buffer_, 
+                    std::chrono::nanoseconds interval = std::chrono::milliseconds(100),
+                    std::chrono::nanoseconds jitter = std::chrono::nanoseconds::zero()) {
+        if (producers_.contains(symbol)) throw std::invalid_argument("TickStream: duplicate symbol " + symbol);
+        auto lane = std::make_unique<RingBuffer<T>>(lane_capacity_, policy_ == OverflowPolicy::OverwriteOldest);
+        auto producer = std::make_unique<Producer<T>>(
+            scheduler_,
+            *lane, 
             tick_generator,
-            interval
+            interval,
+            jitter
         );
+        producer->set_wait_strategy(wait_);
+        producer->set_overflow_policy(policy_);
+        merger_.add_lane(*lane);
+        lanes_[symbol] = std::move(lane);
         producers_[symbol] = std::move(producer);
     }
+
+    // Add a symbol paced by params.rate_hz with params.latency_jitter_ms of modeled jitter
+    template<typename Callback>
+    void add_symbol(const std::string& symbol, Callback tick_generator, const Params& params) {
+        const auto jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double, std::milli>(params.latency_jitter_ms));
+        add_symbol(symbol, tick_generator, Scheduler::interval_for(params.rate_hz), jitter);
+    }
+    
+    // Applies to existing and future symbols; call while stopped. OverwriteOldest picks
+    // overwritable lanes, so set it before add_symbol (FlatTickStream only).
+    void set_overflow_policy(OverflowPolicy policy) {
+        if (policy == OverflowPolicy::OverwriteOldest && !std::is_trivially_copyable_v<T>)
+            throw std::invalid_argument("TickStream: OverwriteOldest needs FlatTick lanes (FlatTickStream)");
+        for (auto& [symbol, producer] : producers_) {
+            producer->set_overflow_policy(policy);
+        }
+        policy_ = policy;
+    }
     
     // Start all producers
     void start() {
+        started_at_ = std::chrono::steady_clock::now();
         for (auto& [symbol, producer] : producers_) {
             producer->start();
         }
+        scheduler_.start();
     }
     
     // Stop all producers
@@ -43,24 +98,121 @@ public:
         for (auto& [symbol, producer] : producers_) {
             producer->stop();
         }
+        scheduler_.stop();
+        wait_.wake_all();
     }
     
-    // Get the buffer for consumers
-    RingBuffer<Tick>& get_buffer() { return buffer_; }
+    // Timestamp-ordered view over all lanes, for one consumer (Consumer::process)
+    LaneMerger<T>& merger() { return merger_; }
+    
+    // How long the merger holds a tick back while some lane is empty; call while stopped
+    void set_reorder_window(std::chrono::nanoseconds window) { merger_.set_reorder_window(window); }
+    
+    // Per-symbol lane, for consumers that want one symbol without the merge
+    RingBuffer<T>& lane(const std::string& symbol) { return *lanes_.at(symbol); }
+    
+    // Shared by all producers; give it to the consumer via Consumer::set_wait_strategy
+    WaitStrategy& wait_strategy() { return wait_; }
+    
+    // Per-symbol producer (counters: produced/dropped/overwritten)
+    const Producer<T>& producer(const std::string& symbol) const { return *producers_.at(symbol); }
     
     // Get statistics
+    struct SymbolStats {
+        std::string symbol;
+        std::uint64_t produced;
+        std::uint64_t dropped;
+        std::uint64_t overwritten;
+        double produce_rate_hz;               // over the snapshot window
+        double drop_rate_hz;
+    };
+
     struct Stats {
         size_t total_ticks_produced;
         size_t total_ticks_consumed;
         size_t buffer_drops;
+        size_t buffer_overwrites;
+        size_t queue_depth_high_water;
+
+        // enqueue-to-dequeue latency (Consumer::set_stats(stream_stats()) feeds these)
+        std::uint64_t latency_samples;
+        std::uint64_t latency_p50_ns;
+        std::uint64_t latency_p90_ns;
+        std::uint64_t latency_p99_ns;
+        std::uint64_t latency_p999_ns;
+        std::uint64_t latency_max_ns;
+
+        double window_s;                      // time the per-symbol rates refer to
+        std::vector<SymbolStats> symbols;
     };
     
-    Stats get_stats() const { return stats_; }
+    // Aggregates producer counters and consumer-side instrumentation; rates are since start()
+    Stats get_stats() const { return collect(nullptr, std::chrono::steady_clock::now() - started_at_); }
+
+    // Consumer-side sink; attach with Consumer::set_stats
+    StreamStats& stream_stats() { return stream_stats_; }
+
+    // Periodic snapshot/export: hook runs on the scheduler thread every period, with
+    // per-symbol rates over that period. Register before start().
+    void set_stats_hook(std::function<void(const Stats&)> hook, std::chrono::nanoseconds period) {
+        scheduler_.add([this, hook = std::move(hook), prev = Stats{},
+                        last = std::chrono::steady_clock::now()]() mutable {
+            const auto now = std::chrono::steady_clock::now();
+            Stats snapshot = collect(prev.symbols.empty() ? nullptr : &prev, now - last);
+            hook(snapshot);
+            prev = std::move(snapshot);
+            last = now;
+        }, period);
+    }
 
 private:
-    RingBuffer<Tick> buffer_;
-    std::unordered_map<std::string, std::unique_ptr<Producer<Tick>>> producers_;
-    Stats stats_;
+    size_t lane_capacity_;
+    std::unordered_map<std::string, std::unique_ptr<RingBuffer<T>>> lanes_;
+    LaneMerger<T> merger_;
+    WaitStrategy wait_;
+    OverflowPolicy policy_{OverflowPolicy::Block};
+    Scheduler scheduler_; // declared before producers_: outlives them
+    std::unordered_map<std::string, std::unique_ptr<Producer<T>>> producers_;
+    StreamStats stream_stats_;
+    std::chrono::steady_clock::time_point started_at_{std::chrono::steady_clock::now()};
+
+    Stats collect(const Stats* previous, std::chrono::steady_clock::duration window) const {
+        const double window_s = std::max(std::chrono::duration<double>(window).count(), 1e-9);
+        const auto& latency = stream_stats_.latency_ns;
+
+        Stats out{};
+        out.window_s = window_s;
+        out.total_ticks_consumed = stream_stats_.consumed.load();
+        out.queue_depth_high_water = stream_stats_.depth_high_water.load();
+        out.latency_samples = latency.count();
+        out.latency_p50_ns = latency.percentile(0.50);
+        out.latency_p90_ns = latency.percentile(0.90);
+        out.latency_p99_ns = latency.percentile(0.99);
+        out.latency_p999_ns = latency.percentile(0.999);
+        out.latency_max_ns = latency.max();
+
+        out.symbols.reserve(producers_.size());
+        for (const auto& [symbol, producer] : producers_) {
+            SymbolStats s{symbol, producer->produced(), producer->dropped(), producer->overwritten(), 0.0, 0.0};
+            std::uint64_t base_produced = 0, base_dropped = 0;
+            if (previous) {
+                for (const auto& p : previous->symbols) {
+                    if (p.symbol == symbol) { base_produced = p.produced; base_dropped = p.dropped; break; }
+                }
+            }
+            s.produce_rate_hz = static_cast<double>(s.produced - base_produced) / window_s;
+            s.drop_rate_hz = static_cast<double>(s.dropped - base_dropped) / window_s;
+
+            out.total_ticks_produced += s.produced;
+            out.buffer_drops += s.dropped;
+            out.buffer_overwrites += s.overwritten;
+            out.symbols.push_back(std::move(s));
+        }
+        return out;
+    }
 };
 
+using TickStream = BasicTickStream<Tick>;
+using FlatTickStream = BasicTickStream<FlatTick>;
+
 } // namespace tickstream
\ No newline at end of file
@@ -2,30 +2,36 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <cstddef>
 #include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 #include "tickstream/tick.hpp"
 #include "tickstream/params.hpp"
+#include "tickstream/symbols.hpp"
+#include "tickstream/model.hpp"
 
 namespace tickstream {
 
-    /// SPSC ring buffer concept for decoupled producer/consumer.
-    // template <typename T>
-    // class RingBuffer {
-    // public:
-    //     virtual ~RingBuffer() = default;
-    //     virtual bool try_push(const T& item) = 0; // non-blocking, lock-free friendly
-    //     virtual std::size_t capacity() const = 0;
-    //     virtual std::size_t size() const = 0;
-    // };
-
-    /// Pseudo tick stream engine. pImpl hides model details.
+    /// Pseudo tick stream engine. The model is type-erased behind detail::AnyModel,
+    /// so StreamGen has one type whatever composition drives it; Impl is defined
+    /// below, inline in this header.
     class StreamGen {
     public:
         explicit StreamGen(const Params& params);
+
+        // Generator driven by another model composition, e.g.
+        //   StreamGen::with_model<Model<GBM, RegimeSwitch<3>>>(params)
+        template<typename M>
+        static StreamGen with_model(const Params& params);
+
         ~StreamGen();
         StreamGen(StreamGen&&) noexcept;
         StreamGen& operator=(StreamGen&&) noexcept;
@@ -37,21 +43,189 @@ namespace tickstream {
         // Pull model: single-step generation.
         Tick next();
 
-        // Push model: call sink at target rate. count=0 => unbounded.
-        void run(const std::function<void(const Tick&)>& sink, std::size_t count = 0);
+        // Pull model: batch generation. Fills out round-robin over params().symbols,
+        // advancing the whole universe one step every symbols.size() ticks.
+        void next_batch(std::span<Tick> out);
+        void next_batch(std::span<FlatTick> out);
 
-        // Push into a user-supplied SPSC ring buffer.
-        // void run_to_ring(RingBuffer<Tick>& rb, std::size_t count = 0);
+        // Push model: call sink at target rate. count=0 => params().max_count (0 => unbounded).
+        void run(const std::function<void(const Tick&)>& sink, std::size_t count = 0);
 
         // Control
         void set_rate_hz(double hz);
         double rate_hz() const;
+        void stop(); // makes a running run() return after the current tick, or the next run() at once
 
         // Introspection
         const Params& params() const;
 
     private:
         struct Impl;
+        explicit StreamGen(std::unique_ptr<Impl> impl);
         std::unique_ptr<Impl> p_;
     };
+
+    /* ---------------- implementation ---------------- */
+
+    struct StreamGen::Impl {
+        // the model is reached through one virtual step() per universe step; its
+        // output columns never move, so the per-tick reads go straight to them
+        template<typename M>
+        static std::unique_ptr<Impl> make(const Params& params) {
+            if (params.symbols.empty()) throw std::invalid_argument("StreamGen: params.symbols is empty");
+            const std::uint64_t seed =
+                params.seed != 0 ? params.seed : (std::uint64_t{std::random_device{}()} << 32) ^ std::random_device{}();
+            return std::make_unique<Impl>(params,
+                                          std::make_unique<detail::ModelAdapter<M>>(params, params.symbols.size(), seed));
+        }
+
+        Impl(const Params& params, std::unique_ptr<detail::AnyModel> model)
+            : params(params)
+            , engine(std::move(model))
+            , price(engine->price()), bid(engine->bid()), ask(engine->ask()), volume(engine->volume())
+            , sequence(params.symbols.size(), 0)
+            , cursor(params.symbols.size()) {
+            ids.reserve(params.symbols.size());
+            for (const auto& s : params.symbols) ids.push_back(SymbolRegistry::global().intern(s));
+        }
+
+        // step the engine and stamp the step when the current step is exhausted
+        void refill() {
+            engine->step();
+            using namespace std::chrono;
+            unix_ts_ns = static_cast<std::uint64_t>(
+                time_point_cast<nanoseconds>(system_clock::now()).time_since_epoch().count());
+            mono_ts_ns = static_cast<std::uint64_t>(
+                time_point_cast<nanoseconds>(steady_clock::now()).time_since_epoch().count());
+            cursor = 0;
+        }
+
+        template <typename Fill>
+        void generate(std::size_t n, Fill&& fill) {
+            const std::size_t universe = engine->size();
+            std::size_t done = 0;
+            while (done < n) {
+                if (cursor == universe) refill();
+                const std::size_t run = std::min(n - done, universe - cursor);
+                for (std::size_t k = 0; k < run; ++k) fill(done + k, cursor + k);
+                cursor += run;
+                done += run;
+            }
+        }
+
+        void write(FlatTick& t, std::size_t i) {
+            t.price = price[i];
+            t.volume = volume[i];
+            t.bid = bid[i];
+            t.ask = ask[i];
+            t.unix_ts_ns = unix_ts_ns;
+            t.mono_ts_ns = mono_ts_ns;
+            t.symbol_id = ids[i];
+            t.sequence = sequence[i]++;
+            t.n_bids = 0;
+            t.n_asks = 0;
+            t.is_snapshot = false;
+        }
+
+        void write(Tick& t, std::size_t i) {
+            t.symbol = params.symbols[i];
+            t.price = price[i];
+            t.volume = volume[i];
+            t.bid = bid[i];
+            t.ask = ask[i];
+            t.unix_ts_ns = unix_ts_ns;
+            t.mono_ts_ns = mono_ts_ns;
+            t.sequence = sequence[i]++;
+            t.is_snapshot = false;
+            t.bids.clear();
+            t.asks.clear();
+        }
+
+        Params params;
+        std::unique_ptr<detail::AnyModel> engine;
+        const double* price;              // engine output columns
+        const double* bid;
+        const double* ask;
+        const double* volume;
+        std::vector<SymbolId> ids;
+        std::vector<std::uint32_t> sequence;
+        std::size_t cursor;               // next symbol to emit from the current step
+        std::uint64_t unix_ts_ns{0};
+        std::uint64_t mono_ts_ns{0};
+        std::atomic<bool> stopping{false};
+    };
+
+    inline StreamGen::StreamGen(const Params& params) : p_(Impl::make<DefaultModel>(params)) {}
+
+    inline StreamGen::StreamGen(std::unique_ptr<Impl> impl) : p_(std::move(impl)) {}
+
+    template<typename M>
+    inline StreamGen StreamGen::with_model(const Params& params) {
+        return StreamGen(Impl::make<M>(params));
+    }
+
+    inline StreamGen::~StreamGen() = default;
+    inline StreamGen::StreamGen(StreamGen&&) noexcept = default;
+    inline StreamGen& StreamGen::operator=(StreamGen&&) noexcept = default;
+
+    inline Tick StreamGen::next() {
+        Tick t{};
+        next_batch(std::span<Tick>(&t, 1));
+        return t;
+    }
+
+    inline void StreamGen::next_batch(std::span<Tick> out) {
+        p_->generate(out.size(), [&](std::size_t o, std::size_t i) { p_->write(out[o], i); });
+    }
+
+    inline void StreamGen::next_batch(std::span<FlatTick> out) {
+        p_->generate(out.size(), [&](std::size_t o, std::size_t i) { p_->write(out[o], i); });
+    }
+
+    inline void StreamGen::run(const std::function<void(const Tick&)>& sink, std::size_t count) {
+        using clock = std::chrono::steady_clock;
+        if (count == 0) count = p_->params.max_count;
+        // a stop() from before or during this call is consumed on the way out, however run() ends
+        struct ClearStop {
+            std::atomic<bool>& stopping;
+            ~ClearStop() { stopping.store(false, std::memory_order_relaxed); }
+        } clear_stop{p_->stopping};
+
+        // one step (all symbols) per 1/rate_hz, scheduled against absolute deadlines
+        const std::size_t universe = p_->engine->size();
+        std::vector<Tick> batch(universe);
+        auto deadline = clock::now();
+        std::size_t emitted = 0;
+        while (count == 0 || emitted < count) {
+            if (p_->stopping.load(std::memory_order_relaxed)) return;
+            if (emitted != 0) std::this_thread::sleep_until(deadline);
+            const std::size_t n = count == 0 ? universe : std::min(universe, count - emitted);
+            next_batch(std::span<Tick>(batch.data(), n));
+            for (std::size_t k = 0; k < n; ++k) {
+                if (p_->stopping.load(std::memory_order_relaxed)) return;
+                sink(batch[k]);
+            }
+            emitted += n;
+            deadline += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / p_->params.rate_hz));
+        }
+    }
+
+    inline void StreamGen::set_rate_hz(double hz) {
+        Params next = p_->params;
+        next.rate_hz = hz;
+        p_->engine->set_params(next); // validates
+        p_->params = next;
+    }
+
+    inline double StreamGen::rate_hz() const {
+        return p_->params.rate_hz;
+    }
+
+    inline void StreamGen::stop() {
+        p_->stopping.store(true, std::memory_order_relaxed);
+    }
+
+    inline const Params& StreamGen::params() const {
+        return p_->params;
+    }
 }
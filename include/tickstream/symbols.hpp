@@ -0,0 +1,69 @@
+// include/tickstream/symbols.hpp
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace tickstream {
+
+    /// Compact, dense symbol handle (index into a SymbolRegistry).
+    using SymbolId = std::uint32_t;
+
+    /// Interns symbol names to dense ids so hot-path ticks carry 4 bytes instead of a string.
+    /// Interning takes a unique lock and is meant for setup; lookups take a shared lock.
+    class SymbolRegistry {
+    public:
+        // process-wide default registry
+        static SymbolRegistry& global() {
+            static SymbolRegistry registry;
+            return registry;
+        }
+
+        // returns the existing id for name, or assigns the next free one
+        SymbolId intern(std::string_view name) {
+            {
+                std::shared_lock lock(mutex_);
+                if (auto it = ids_.find(name); it != ids_.end()) return it->second;
+            }
+            std::unique_lock lock(mutex_);
+            if (auto it = ids_.find(name); it != ids_.end()) return it->second;
+
+            const auto id = static_cast<SymbolId>(names_.size());
+            const std::string& stored = names_.emplace_back(name); // deque keeps addresses stable
+            ids_.emplace(std::string_view(stored), id);
+            return id;
+        }
+
+        std::optional<SymbolId> find(std::string_view name) const {
+            std::shared_lock lock(mutex_);
+            if (auto it = ids_.find(name); it != ids_.end()) return it->second;
+            return std::nullopt;
+        }
+
+        // name for a previously interned id; view stays valid for the registry's lifetime
+        std::string_view name(SymbolId id) const {
+            std::shared_lock lock(mutex_);
+            if (id >= names_.size()) throw std::out_of_range("SymbolRegistry: unknown symbol id");
+            return names_[id];
+        }
+
+        std::size_t size() const {
+            std::shared_lock lock(mutex_);
+            return names_.size();
+        }
+
+    private:
+        mutable std::shared_mutex mutex_;
+        std::deque<std::string> names_;
+        std::unordered_map<std::string_view, SymbolId> ids_; // keys view into names_
+    };
+
+} // namespace tickstream
@@ -2,11 +2,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <string>
 #include <utility>
 #include <chrono>
 #include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+#include "symbols.hpp"
 
 namespace tickstream {
 
@@ -48,6 +54,89 @@ namespace tickstream {
         return os;
     }
 
+    /* Fixed-layout tick for the hot path: trivially copyable, no heap. */
+
+    struct Level {
+        double price;
+        double qty;
+    };
+
+    inline constexpr std::size_t flat_depth = 4; // inline book levels per side
+
+    struct alignas(64) FlatTick {
+        // first cache line: top of book + identity
+        double price;
+        double volume;
+        double bid;
+        double ask;
+
+        std::uint64_t unix_ts_ns;       // external timestamp (system_clock)
+        std::uint64_t mono_ts_ns;       // monotonic timestamp (steady_clock)
+
+        SymbolId symbol_id;             // see SymbolRegistry
+        std::uint32_t sequence;
+
+        std::uint8_t n_bids = 0;        // valid entries in bids
+        std::uint8_t n_asks = 0;        // valid entries in asks
+        bool is_snapshot = false;
+
+        // following cache lines: inline depth
+        std::array<Level, flat_depth> bids;
+        std::array<Level, flat_depth> asks;
+    };
+
+    static_assert(std::is_trivially_copyable_v<FlatTick>);
+    static_assert(sizeof(FlatTick) == 192); // three cache lines
+
+    // rich -> flat; interns the symbol and truncates depth to flat_depth levels
+    inline FlatTick to_flat(const Tick& t, SymbolRegistry& registry = SymbolRegistry::global()) {
+        FlatTick f{
+            .price = t.price,
+            .volume = t.volume,
+            .bid = t.bid,
+            .ask = t.ask,
+            .unix_ts_ns = t.unix_ts_ns,
+            .mono_ts_ns = t.mono_ts_ns,
+            .symbol_id = registry.intern(t.symbol),
+            .sequence = t.sequence,
+            .n_bids = static_cast<std::uint8_t>(std::min(t.bids.size(), flat_depth)),
+            .n_asks = static_cast<std::uint8_t>(std::min(t.asks.size(), flat_depth)),
+            .is_snapshot = t.is_snapshot,
+            .bids = {},
+            .asks = {}
+        };
+        for (std::size_t i = 0; i < f.n_bids; ++i) f.bids[i] = {t.bids[i].first, t.bids[i].second};
+        for (std::size_t i = 0; i < f.n_asks; ++i) f.asks[i] = {t.asks[i].first, t.asks[i].second};
+        return f;
+    }
+
+    // flat -> rich, for display and non-hot-path consumers
+    inline Tick to_tick(const FlatTick& f, const SymbolRegistry& registry = SymbolRegistry::global()) {
+        Tick t{
+            .symbol = std::string(registry.name(f.symbol_id)),
+            .price = f.price,
+            .volume = f.volume,
+            .bid = f.bid,
+            .ask = f.ask,
+            .unix_ts_ns = f.unix_ts_ns,
+            .mono_ts_ns = f.mono_ts_ns,
+            .sequence = f.sequence,
+            .is_snapshot = f.is_snapshot,
+            .bids = {},
+            .asks = {}
+        };
+        t.bids.reserve(f.n_bids);
+        t.asks.reserve(f.n_asks);
+        for (std::size_t i = 0; i < f.n_bids; ++i) t.bids.emplace_back(f.bids[i].price, f.bids[i].qty);
+        for (std::size_t i = 0; i < f.n_asks; ++i) t.asks.emplace_back(f.asks[i].price, f.asks[i].qty);
+        return t;
+    }
+
+    // stream output operator for FlatTick (resolves the symbol via the global registry)
+    inline std::ostream& operator<<(std::ostream& os, const FlatTick& f) {
+        return os << to_tick(f);
+    }
+
     // create sample tick for BTC-USD
     inline Tick tick_btc() {
         using namespace std::chrono;
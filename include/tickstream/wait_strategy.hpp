@@ -0,0 +1,91 @@
+// include/tickstream/wait_strategy.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "detail/cache_line.hpp"
+#include "detail/cpu_relax.hpp"
+
+namespace tickstream {
+
+    enum class WaitKind {
+        BusySpin,  // lowest handoff latency, burns a core
+        SpinYield, // spin briefly, then yield the core between checks
+        Blocking   // spin briefly, then sleep on an atomic wait until signal()
+    };
+
+    /// How a producer or consumer waits for its ring to become ready.
+    ///
+    /// One WaitStrategy is shared by both ends of a ring: each side calls signal()
+    /// after it publishes or frees slots. signal() is a single uncontended RMW and
+    /// only enters the kernel when the other side is actually blocked.
+    class WaitStrategy {
+    public:
+        explicit WaitStrategy(WaitKind kind = WaitKind::SpinYield, std::uint32_t spin_limit = 256)
+            : kind_(kind), spin_limit_(spin_limit) {}
+
+        WaitStrategy(const WaitStrategy&) = delete;
+        WaitStrategy& operator=(const WaitStrategy&) = delete;
+
+        // wait until ready() holds or running becomes false; returns ready()
+        template <typename Ready>
+        bool wait(Ready&& ready, const std::atomic<bool>& running) {
+            for (std::uint32_t i = 0; kind_ == WaitKind::BusySpin || i < spin_limit_; ++i) {
+                if (ready()) return true;
+                if (!running.load(std::memory_order_relaxed)) return false;
+                detail::cpu_relax();
+            }
+
+            if (kind_ == WaitKind::SpinYield) {
+                while (!ready()) {
+                    if (!running.load(std::memory_order_relaxed)) return false;
+                    std::this_thread::yield();
+                }
+                return true;
+            }
+
+            // Blocking: register as a waiter, then re-check before sleeping so a
+            // signal() that raced with the registration is never lost
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            bool ok = false;
+            while (running.load(std::memory_order_relaxed)) {
+                const std::uint32_t seen = epoch_.load(std::memory_order_seq_cst);
+                if (ready()) { ok = true; break; }
+                epoch_.wait(seen, std::memory_order_seq_cst);
+            }
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+            return ok || ready();
+        }
+
+        // call after publishing (producer) or freeing slots (consumer)
+        void signal() {
+            if (kind_ != WaitKind::Blocking) return;
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            if (waiters_.load(std::memory_order_seq_cst) != 0) epoch_.notify_all();
+        }
+
+        // unconditional wake-up, e.g. after clearing a running flag
+        void wake_all() {
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            epoch_.notify_all();
+        }
+
+        WaitKind kind() const { return kind_; }
+
+    private:
+        const WaitKind kind_;
+        const std::uint32_t spin_limit_;
+        alignas(detail::cache_line_size) std::atomic<std::uint32_t> epoch_{0};
+        std::atomic<std::uint32_t> waiters_{0};
+    };
+
+    enum class OverflowPolicy {
+        Block,          // hold the tick and retry on the next fire (never loses data while running)
+        DropNewest,     // discard the tick being pushed
+        OverwriteOldest // evict the oldest queued tick (needs an overwritable ring)
+    };
+
+} // namespace tickstream
@@ -1,50 +1,224 @@
 // Created by @bodeby on 03/10/2025.
+//
+// Streams generated ticks to stdout or a file.
+//
+//   tickstream_cli [--format csv|jsonl|binary] [--output <path>|-] [--count <n>]
+//                  [--symbols A,B,...] [--seed <n>] [--rate <hz>] [--paced]
+//                  [--<param> <value>] ...
 
-#include <iostream>
-#include <ostream>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
 
 // internal includes
-#include <tickstream/tick.hpp>
+#include <tickstream/encoding.hpp>
 #include <tickstream/params.hpp>
 #include <tickstream/stream_gen.hpp>
-#include <tickstream/ring_buffer.hpp>
-#include <tickstream/producer.hpp>
-#include <tickstream/consumer.hpp>
+#include <tickstream/tick.hpp>
 
 namespace ts = tickstream;                      // local alias
 
-using TickBuffer   = ts::RingBuffer<ts::Tick>;  // semantic alias
-using TickConsumer = ts::Consumer<ts::Tick>;    // semantic alias
-using TickProducer = ts::Producer<ts::Tick>;    // semantic alias
+namespace {
 
-int main()
-{
-    TickBuffer ring_buffer(1024); // Create a ring buffer with capacity 1024 (stack allocated)
-    TickConsumer consumer();
-    TickProducer producer();
+    // set by SIGINT/SIGTERM: the stream loops stop and main closes the writer
+    std::atomic<bool> interrupted{false};
+    static_assert(std::atomic<bool>::is_always_lock_free);
+
+    extern "C" void on_signal(int) { interrupted.store(true, std::memory_order_relaxed); }
+
+    // model parameters settable as --<name> <value>
+    struct DoubleParam {
+        const char* name;
+        double ts::Params::*field;
+    };
+
+    constexpr DoubleParam double_params[] = {
+        {"rate", &ts::Params::rate_hz},
+        {"mu", &ts::Params::mu},
+        {"kappa", &ts::Params::kappa},
+        {"drift", &ts::Params::drift},
+        {"sigma0", &ts::Params::sigma0},
+        {"sigma1", &ts::Params::sigma1},
+        {"p01", &ts::Params::p01},
+        {"p10", &ts::Params::p10},
+        {"lambda-jump", &ts::Params::lambda_jump},
+        {"jump-mean", &ts::Params::jump_mean},
+        {"jump-std", &ts::Params::jump_std},
+        {"tick-size", &ts::Params::tick_size},
+        {"sigma-micro", &ts::Params::sigma_micro},
+    };
+
+    struct Options {
+        ts::Params params;
+        ts::Format format = ts::Format::Csv;
+        std::string output = "-";
+        std::size_t batch = 4096;
+        bool paced = false;
+    };
 
-    auto tick_1 = ts::tick_btc();
-    auto tick_2 = ts::tick_btc();
+    void usage(const char* argv0) {
+        std::fprintf(stderr,
+                     "usage: %s [--format csv|jsonl|binary] [--output <path>|-] [--count <n>]\n"
+                     "          [--symbols A,B,...] [--seed <n>] [--batch <n>] [--paced]\n"
+                     "          [--<param> <value>] ...\n"
+                     "params:",
+                     argv0);
+        for (const auto& p : double_params) std::fprintf(stderr, " %s", p.name);
+        std::fprintf(stderr, "\n--count 0 streams until interrupted; --paced emits at --rate steps per second\n");
+    }
 
-    std::cout << tick_1 << "\n";
-    std::cout << tick_2 << "\n";
+    double to_double(std::string_view flag, const char* value) {
+        char* end = nullptr;
+        const double v = std::strtod(value, &end);
+        if (end == value || *end != '\0') throw std::invalid_argument(std::string(flag) + ": not a number: " + value);
+        return v;
+    }
 
-    bool pushed_1 = ring_buffer.try_push(tick_1);
-    bool pushed_2 = ring_buffer.try_push(tick_2);
+    std::uint64_t to_count(std::string_view flag, const char* value) {
+        // strtoull skips blanks and wraps a leading '-' around
+        if (!std::isdigit(static_cast<unsigned char>(value[0]))) throw std::invalid_argument(std::string(flag) + ": not a count: " + value);
+        char* end = nullptr;
+        const unsigned long long v = std::strtoull(value, &end, 10);
+        if (end == value || *end != '\0') throw std::invalid_argument(std::string(flag) + ": not a count: " + value);
+        return v;
+    }
 
-    std::cout << "Pushed BTC tick: " << (pushed_1 ? "success" : "failure") << "\n";
-    std::cout << "Pushed ETH tick: " << (pushed_2 ? "success" : "failure") << "\n";
-    std::cout << "Ring buffer size after pushes: " << ring_buffer.size() << "\n";
+    std::vector<std::string> split(std::string_view list) {
+        std::vector<std::string> out;
+        while (!list.empty()) {
+            const std::size_t comma = list.find(',');
+            if (comma != 0) out.emplace_back(list.substr(0, comma));
+            if (comma == std::string_view::npos) break;
+            list.remove_prefix(comma + 1);
+        }
+        return out;
+    }
+
+    Options parse(int argc, char** argv) {
+        Options o;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            if (arg == "--paced") {
+                o.paced = true;
+                continue;
+            }
+            if (arg.substr(0, 2) != "--" || i + 1 >= argc) throw std::invalid_argument("unexpected argument " + std::string(arg));
+            const std::string_view flag = arg.substr(2);
+            const char* value = argv[++i];
+
+            if (flag == "format") o.format = ts::parse_format(value);
+            else if (flag == "output") o.output = value;
+            else if (flag == "count") o.params.max_count = to_count(arg, value);
+            else if (flag == "seed") o.params.seed = to_count(arg, value);
+            else if (flag == "batch") o.batch = std::max<std::uint64_t>(to_count(arg, value), 1);
+            else if (flag == "symbols") o.params.symbols = split(value);
+            else {
+                bool known = false;
+                for (const auto& p : double_params) {
+                    if (flag == p.name) {
+                        o.params.*p.field = to_double(arg, value);
+                        known = true;
+                    }
+                }
+                if (!known) throw std::invalid_argument("unknown option " + std::string(arg));
+            }
+        }
+        return o;
+    }
+
+    // free-running: as fast as the generator and the encoder allow
+    void stream(ts::StreamGen& gen, ts::TickWriter& out, std::uint64_t count, std::size_t batch) {
+        std::vector<ts::FlatTick> ticks(batch);
+        for (std::uint64_t done = 0; (count == 0 || done < count) && !interrupted.load(std::memory_order_relaxed);) {
+            const std::size_t n = count == 0 ? batch : static_cast<std::size_t>(std::min<std::uint64_t>(batch, count - done));
+            gen.next_batch(std::span<ts::FlatTick>(ticks.data(), n));
+            out.write(std::span<const ts::FlatTick>(ticks.data(), n));
+            done += n;
+        }
+    }
+
+    // one universe step per 1/rate_hz, flushed as it is produced
+    void stream_paced(ts::StreamGen& gen, ts::TickWriter& out, std::uint64_t count) {
+        using clock = std::chrono::steady_clock;
+        const std::size_t universe = gen.params().symbols.size();
+        const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / gen.rate_hz()));
+        std::vector<ts::FlatTick> ticks(universe);
+        auto deadline = clock::now();
+        for (std::uint64_t done = 0; count == 0 || done < count;) {
+            // sleep in short slices so a signal ends the stream promptly at low rates
+            for (auto now = clock::now(); now < deadline && !interrupted.load(std::memory_order_relaxed); now = clock::now()) {
+                std::this_thread::sleep_until(std::min(deadline, now + std::chrono::milliseconds(50)));
+            }
+            if (interrupted.load(std::memory_order_relaxed)) break;
+            const std::size_t n = count == 0 ? universe : static_cast<std::size_t>(std::min<std::uint64_t>(universe, count - done));
+            gen.next_batch(std::span<ts::FlatTick>(ticks.data(), n));
+            out.write(std::span<const ts::FlatTick>(ticks.data(), n));
+            out.flush();
+            done += n;
+            deadline += period;
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--help") == 0) {
+            usage(argv[0]);
+            return 0;
+        }
+    }
 
-    bool popped_1 = ring_buffer.try_pop(tick_1);
-    bool popped_2 = ring_buffer.try_pop(tick_2);
+    Options options;
+    try {
+        options = parse(argc, argv);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        usage(argv[0]);
+        return 2;
+    }
 
-    std::cout << "Popped BTC tick: " << (popped_1 ? "success" : "failure") << "\n";
-    std::cout << "Popped ETH tick: " << (popped_2 ? "success" : "failure") << "\n";
-    std::cout << "Ring buffer size after pops: " << ring_buffer.size() << "\n";
+    // a closed pipe (e.g. `| head`) ends the stream quietly instead of killing the process
+    std::signal(SIGPIPE, SIG_IGN);
+    // Ctrl-C / kill end the stream loop, so the buffered records are still written out
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
 
-    bool pushed_3 = ring_buffer.try_push(tick_1);
-    ring_buffer.clear(); // Clear the buffer
-    std::cout << "Ring buffer size after clear: " << ring_buffer.size() << "\n";
-    std::cout << "Popped tick price: " << tick_1.price << "\n";
-};
\ No newline at end of file
+    try {
+        ts::StreamGen gen(options.params);
+        const std::uint64_t count = options.params.max_count;
+        if (options.output == "-") {
+            ts::TickWriter out(STDOUT_FILENO, options.format);
+            options.paced ? stream_paced(gen, out, count) : stream(gen, out, count, options.batch);
+            out.close();
+        } else {
+            ts::TickWriter out(options.output, options.format);
+            options.paced ? stream_paced(gen, out, count) : stream(gen, out, count, options.batch);
+            out.close();
+        }
+    } catch (const std::system_error& e) {
+        if (e.code() == std::errc::broken_pipe) return 0;
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
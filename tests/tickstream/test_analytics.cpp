@@ -0,0 +1,212 @@
+// tests/tickstream/test_analytics.cpp
+#include "catch_amalgamated.hpp"
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+// internal includes
+#include <tickstream/analytics.hpp>
+#include <tickstream/consumer.hpp>
+#include <tickstream/stream_gen.hpp>
+
+namespace ts = tickstream; // local alias
+using namespace std::chrono_literals;
+using Catch::Approx;
+
+namespace {
+    ts::FlatTick tick(ts::SymbolId id, double price, double volume, std::uint64_t unix_ns) {
+        ts::FlatTick t{};
+        t.symbol_id = id;
+        t.price = price;
+        t.volume = volume;
+        t.bid = price - 0.01;
+        t.ask = price + 0.01;
+        t.unix_ts_ns = unix_ns;
+        return t;
+    }
+
+    std::vector<ts::FlatTick> generated(std::size_t n) {
+        ts::Params params;
+        params.symbols = {"AN-A", "AN-B", "AN-C", "AN-D"};
+        params.seed = 23;
+        params.rate_hz = 100.0;
+        ts::StreamGen gen(params);
+        std::vector<ts::FlatTick> ticks(n);
+        gen.next_batch(ticks);
+        return ticks;
+    }
+}
+
+TEST_CASE("BarBuilder closes time, volume and tick bars", "[analytics]")
+{
+    std::vector<ts::Bar> bars;
+    const auto collect = [&](const ts::Bar& b) { bars.push_back(b); };
+
+    auto timed = ts::BarBuilder::time(1s, collect);
+    timed.update(tick(1, 10.0, 1, 1'000'000'000));
+    timed.update(tick(1, 12.0, 3, 1'500'000'000));
+    timed.update(tick(1, 9.0, 1, 1'900'000'000));
+    timed.update(tick(2, 50.0, 1, 1'950'000'000)); // another symbol does not close symbol 1
+    REQUIRE(bars.empty());
+    timed.update(tick(1, 11.0, 2, 3'100'000'000)); // skips the empty bucket [2s, 3s)
+    REQUIRE(bars.size() == 1);
+    CHECK(bars[0].symbol_id == 1);
+    CHECK(bars[0].ticks == 3);
+    CHECK(bars[0].open == 10.0);
+    CHECK(bars[0].high == 12.0);
+    CHECK(bars[0].low == 9.0);
+    CHECK(bars[0].close == 9.0);
+    CHECK(bars[0].volume == 5.0);
+    CHECK(bars[0].vwap == Approx((10.0 + 36.0 + 9.0) / 5.0));
+    CHECK(bars[0].start_ns == 1'000'000'000);
+    CHECK(timed.current(1)->start_ns == 3'000'000'000);
+    timed.flush();
+    CHECK(bars.size() == 3);
+
+    bars.clear();
+    auto by_volume = ts::BarBuilder::volume(10.0, collect);
+    for (int i = 0; i < 7; ++i) by_volume.update(tick(0, 100.0 + i, 3, i));
+    CHECK(bars.size() == 1);  // 3+3+3+3 crosses 10 on the 4th tick
+    CHECK(bars[0].volume == 12.0);
+
+    bars.clear();
+    auto by_ticks = ts::BarBuilder::ticks(5, collect);
+    for (int i = 0; i < 12; ++i) by_ticks.update(tick(0, 1.0 + i, 1, i));
+    REQUIRE(bars.size() == 2);
+    CHECK(bars[1].open == 6.0);
+    CHECK(bars[1].close == 10.0);
+}
+
+TEST_CASE("Vwap, EwmaPrice and SpreadStats match direct computation", "[analytics]")
+{
+    const auto ticks = generated(4000);
+    ts::Vwap vwap;
+    ts::EwmaPrice ewma(0.05);
+    ts::SpreadStats spread;
+    vwap.update(std::span<const ts::FlatTick>(ticks));
+    ewma.update(std::span<const ts::FlatTick>(ticks));
+    spread.update(std::span<const ts::FlatTick>(ticks));
+
+    const auto id = ticks[0].symbol_id;
+    double pv = 0.0, v = 0.0, m = 0.0, var = 0.0, smin = 1e9, smax = -1e9;
+    bool first = true;
+    for (const auto& t : ticks) {
+        if (t.symbol_id != id) continue;
+        pv += t.price * t.volume;
+        v += t.volume;
+        if (first) { m = t.price; first = false; }
+        else {
+            const double d = t.price - m;
+            m += 0.05 * d;
+            var = 0.95 * (var + 0.05 * d * d);
+        }
+        smin = std::min(smin, t.ask - t.bid);
+        smax = std::max(smax, t.ask - t.bid);
+    }
+    CHECK(vwap.value(id) == Approx(pv / v));
+    CHECK(ewma.mean(id) == Approx(m));
+    CHECK(ewma.variance(id) == Approx(var));
+    CHECK(spread.count(id) == 1000);
+    CHECK(spread.min(id) == Approx(smin));
+    CHECK(spread.max(id) == Approx(smax));
+    CHECK(std::isnan(vwap.value(9999)));
+    CHECK(ts::EwmaPrice::with_half_life(1.0).alpha() == Approx(0.5));
+}
+
+TEST_CASE("Dense column paths agree with per-tick updates", "[analytics]")
+{
+    const auto ticks = generated(4000);
+    const auto first = ticks[0].symbol_id;
+    REQUIRE(ticks[3].symbol_id == first + 3); // freshly interned universe: contiguous ids
+
+    ts::Vwap vwap_tick, vwap_dense;
+    ts::EwmaPrice ewma_tick(0.1), ewma_dense(0.1);
+    ts::SpreadStats spread_tick, spread_dense;
+    for (std::size_t step = 0; step < ticks.size(); step += 4) {
+        double price[4], volume[4], bid[4], ask[4];
+        for (std::size_t k = 0; k < 4; ++k) {
+            const auto& t = ticks[step + k];
+            price[k] = t.price; volume[k] = t.volume; bid[k] = t.bid; ask[k] = t.ask;
+            vwap_tick.update(t);
+            ewma_tick.update(t);
+            spread_tick.update(t);
+        }
+        vwap_dense.update_dense(first, price, volume);
+        ewma_dense.update_dense(first, price);
+        spread_dense.update_dense(first, bid, ask);
+    }
+    for (ts::SymbolId id = first; id < first + 4; ++id) {
+        CHECK(vwap_dense.value(id) == vwap_tick.value(id));
+        CHECK(ewma_dense.mean(id) == ewma_tick.mean(id));
+        CHECK(ewma_dense.variance(id) == ewma_tick.variance(id));
+        CHECK(spread_dense.mean(id) == spread_tick.mean(id));
+    }
+}
+
+TEST_CASE("RollingVolatility tracks the last window of log returns", "[analytics]")
+{
+    const auto ticks = generated(2000);
+    const auto id = ticks[1].symbol_id;
+    ts::RollingVolatility vol(50);
+
+    std::vector<double> prices;
+    for (const auto& t : ticks) {
+        vol.update(t);
+        if (t.symbol_id == id) prices.push_back(t.price);
+    }
+    REQUIRE(vol.samples(id) == 50);
+
+    double sum = 0.0, sumsq = 0.0;
+    for (std::size_t k = prices.size() - 50; k < prices.size(); ++k) {
+        const double r = std::log(prices[k] / prices[k - 1]);
+        sum += r;
+        sumsq += r * r;
+    }
+    const double mean = sum / 50.0;
+    CHECK(vol.value(id) == Approx(std::sqrt((sumsq - 50.0 * mean * mean) / 49.0)).margin(1e-12));
+}
+
+TEST_CASE("Analytics operators plug into Consumer handlers", "[analytics]")
+{
+    ts::RingBuffer<ts::Tick> rb(64);
+    ts::Consumer<ts::Tick> consumer;
+    ts::Vwap vwap;
+    ts::SpreadStats spread;
+    consumer.subscribe(std::ref(vwap));
+    consumer.subscribe(std::ref(spread));
+
+    for (int i = 0; i < 10; ++i) rb.try_push(ts::tick_btc());
+    REQUIRE(consumer.process(rb) == 10);
+
+    const auto id = *ts::SymbolRegistry::global().find(ts::tick_btc().symbol);
+    CHECK(vwap.value(id) == Approx(ts::tick_btc().price));
+    CHECK(spread.count(id) == 10);
+}
+
+TEST_CASE("EwmaVolatility follows the hand-computed recurrence on log returns", "[analytics]")
+{
+    ts::EwmaVolatility vol(0.5);
+    CHECK(ts::EwmaVolatility::with_half_life(1.0).alpha() == Approx(0.5));
+
+    vol.update(tick(3, 100.0, 1, 0));
+    CHECK(vol.samples(3) == 0);
+    vol.update(tick(3, 101.0, 1, 1));
+    CHECK(std::isnan(vol.value(3)));                        // one return: no dispersion yet
+    CHECK(vol.mean_return(3) == Approx(std::log(1.01)));
+    vol.update(tick(3, 99.0, 1, 2));
+    CHECK(vol.value(3) == Approx(0.014975498779918817));
+    vol.update(tick(3, 102.0, 1, 3));
+    CHECK(vol.value(3) == Approx(0.02040229861314321));
+
+    // a steady trend has constant returns, hence no volatility, whatever the level does
+    ts::EwmaVolatility trend(0.1);
+    ts::EwmaPrice level(0.1);
+    double price = 100.0;
+    for (int i = 0; i < 200; ++i, price *= 1.01) {
+        trend.update(tick(4, price, 1, i));
+        level.update(tick(4, price, 1, i));
+    }
+    CHECK(trend.value(4) == Approx(0.0).margin(1e-12));
+    CHECK(level.stddev(4) > 1.0);
+}
@@ -0,0 +1,117 @@
+// tests/tickstream/test_book.cpp
+#include "catch_amalgamated.hpp"
+
+#include <vector>
+
+// internal includes
+#include <tickstream/book.hpp>
+
+namespace ts = tickstream; // local alias
+
+namespace {
+    ts::BookDelta delta(ts::Side side, ts::BookAction action, std::int32_t px, double qty, std::uint8_t level = 0) {
+        ts::BookDelta d{};
+        d.side = side;
+        d.action = action;
+        d.price_ticks = px;
+        d.qty = qty;
+        d.level = level;
+        return d;
+    }
+
+    ts::Params universe() {
+        ts::Params params;
+        params.symbols = {"BOOK-A", "BOOK-B", "BOOK-C"};
+        params.seed = 17;
+        params.rate_hz = 100.0;
+        params.sigma0 = 0.05; // the touch moves about a tick per step
+        return params;
+    }
+}
+
+TEST_CASE("L2Book keeps both sides sorted best-first", "[book]")
+{
+    ts::L2Book<4> book;
+    REQUIRE(book.apply(delta(ts::Side::Bid, ts::BookAction::Add, 100, 5)));
+    REQUIRE(book.apply(delta(ts::Side::Bid, ts::BookAction::Add, 102, 7, 3))); // stale hint: falls back to a scan
+    REQUIRE(book.apply(delta(ts::Side::Bid, ts::BookAction::Add, 101, 6, 1)));
+    REQUIRE(book.apply(delta(ts::Side::Ask, ts::BookAction::Add, 104, 1)));
+    REQUIRE(book.apply(delta(ts::Side::Ask, ts::BookAction::Add, 103, 2)));
+
+    REQUIRE(book.levels(ts::Side::Bid) == 3);
+    CHECK(book.price_ticks(ts::Side::Bid, 0) == 102);
+    CHECK(book.price_ticks(ts::Side::Bid, 2) == 100);
+    CHECK(book.price_ticks(ts::Side::Ask, 0) == 103);
+
+    REQUIRE(book.apply(delta(ts::Side::Bid, ts::BookAction::Modify, 101, 60, 1)));
+    CHECK(book.qty(ts::Side::Bid, 1) == 60);
+    REQUIRE(book.apply(delta(ts::Side::Bid, ts::BookAction::Delete, 102, 0)));
+    CHECK(book.price_ticks(ts::Side::Bid, 0) == 101);
+    CHECK_FALSE(book.apply(delta(ts::Side::Ask, ts::BookAction::Modify, 999, 1)));
+
+    ts::FlatTick t{};
+    book.copy_to(t, 0.5);
+    CHECK(t.n_bids == 2);
+    CHECK(t.bid == 50.5);
+    CHECK(t.asks[1].price == 52.0);
+
+    REQUIRE(book.apply(delta(ts::Side::Bid, ts::BookAction::Clear, 0, 0)));
+    CHECK(book.empty());
+}
+
+TEST_CASE("BookBuilder mirrors the simulated books from deltas alone", "[book]")
+{
+    ts::BookOptions options;
+    options.snapshot_every = 50;
+    ts::BookStream<8> stream(universe(), options);
+    ts::BookBuilder<8> builder;
+
+    std::vector<ts::BookDelta> deltas;
+    std::size_t total = 0;
+    for (int step = 0; step < 400; ++step) {
+        deltas.clear();
+        total += stream.next_step(deltas);
+        for (const auto& d : deltas) REQUIRE(builder.apply(d));
+        REQUIRE(deltas.back().flags & ts::BookDelta::end_of_batch);
+    }
+    CHECK(builder.gaps() == 0);
+
+    const auto& sim = stream.sim();
+    const auto symbols = universe().symbols;
+    for (std::size_t i = 0; i < sim.size(); ++i) {
+        const auto id = *ts::SymbolRegistry::global().find(symbols[i]);
+        REQUIRE(builder.synced(id));
+        const auto& book = builder.book(id);
+        REQUIRE(book == sim.book(i));
+        REQUIRE(book.levels(ts::Side::Bid) == 8);
+        REQUIRE(book.price_ticks(ts::Side::Bid, 0) < book.price_ticks(ts::Side::Ask, 0));
+    }
+
+    // a fraction of the levels a full book per step would carry
+    CHECK(total < 400 * 3 * 2 * 8 / 2);
+}
+
+TEST_CASE("BookBuilder resyncs on the next snapshot after a gap", "[book]")
+{
+    ts::BookOptions options;
+    options.snapshot_every = 10;
+    ts::BookStream<4> stream(universe(), options);
+    ts::BookBuilder<4> builder;
+
+    std::vector<ts::BookDelta> deltas;
+    for (int step = 0; step < 5; ++step) stream.next_step(deltas);
+
+    // join late: nothing applies until the refresh at update 10
+    const auto id = deltas.front().symbol_id;
+    std::size_t skipped = deltas.size() / 2;
+    for (std::size_t k = skipped; k < deltas.size(); ++k) {
+        if (deltas[k].symbol_id == id) CHECK_FALSE(builder.apply(deltas[k]));
+    }
+    CHECK_FALSE(builder.synced(id));
+
+    deltas.clear();
+    for (int step = 5; step < 11; ++step) stream.next_step(deltas);
+    for (const auto& d : deltas) builder.apply(d);
+    REQUIRE(builder.synced(id));
+    CHECK(builder.book(id) == stream.sim().book(0));
+}
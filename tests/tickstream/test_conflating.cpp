@@ -0,0 +1,100 @@
+// tests/tickstream/test_conflating.cpp
+#include "catch_amalgamated.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// internal includes
+#include <tickstream/conflating.hpp>
+#include <tickstream/consumer.hpp>
+#include <tickstream/tick.hpp>
+
+namespace ts = tickstream; // local alias
+using namespace std::chrono_literals;
+
+namespace {
+    ts::FlatTick tick(ts::SymbolId id, std::uint32_t sequence) {
+        ts::FlatTick t{};
+        t.symbol_id = id;
+        t.sequence = sequence;
+        t.price = sequence;                    // redundant copies to detect torn reads
+        t.volume = sequence;
+        t.mono_ts_ns = sequence;
+        return t;
+    }
+}
+
+TEST_CASE("ConflatingBuffer keeps the latest value per slot", "[conflating]")
+{
+    ts::ConflatingBuffer<ts::FlatTick> buffer(130); // spans three dirty words
+    CHECK(buffer.empty());
+
+    for (std::uint32_t s = 1; s <= 5; ++s) REQUIRE(buffer.publish(tick(3, s)));
+    REQUIRE(buffer.publish(tick(129, 7)));
+    CHECK_FALSE(buffer.publish(tick(130, 1)));
+    CHECK_FALSE(buffer.empty());
+
+    std::vector<std::pair<std::size_t, std::uint32_t>> seen;
+    REQUIRE(buffer.drain([&](std::size_t slot, const ts::FlatTick& t) { seen.emplace_back(slot, t.sequence); }) == 2);
+    CHECK(seen == std::vector<std::pair<std::size_t, std::uint32_t>>{{3, 5}, {129, 7}});
+    CHECK(buffer.conflated() == 4);
+    CHECK(buffer.empty());
+    CHECK(buffer.drain([](std::size_t, const ts::FlatTick&) {}) == 0);
+
+    ts::FlatTick out{};
+    REQUIRE(buffer.read(3, out));
+    CHECK(out.sequence == 5);
+    CHECK_FALSE(buffer.read(4, out));
+}
+
+TEST_CASE("ConflatingBuffer readers never see torn values and never block writers", "[conflating]")
+{
+    constexpr std::size_t slots = 8;
+    constexpr std::uint32_t updates = 200000;
+    ts::ConflatingBuffer<ts::FlatTick> buffer(slots);
+
+    std::atomic<bool> running{true};
+    std::atomic<std::uint64_t> torn{0}, delivered{0};
+    std::thread reader([&] {
+        while (running.load() || !buffer.empty()) {
+            delivered += buffer.drain([&](std::size_t, const ts::FlatTick& t) {
+                if (t.price != t.sequence || t.volume != t.sequence || t.mono_ts_ns != t.sequence) ++torn;
+            });
+            std::this_thread::sleep_for(10us); // a slow consumer
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&, w] {
+            for (std::uint32_t s = 1; s <= updates; ++s) buffer.publish(static_cast<std::size_t>(s % slots), tick(0, s * 2 + w));
+        });
+    }
+    for (auto& t : writers) t.join();
+    running = false;
+    reader.join();
+
+    CHECK(torn.load() == 0);
+    CHECK(delivered.load() + buffer.conflated() <= 2 * updates);
+    CHECK(delivered.load() >= slots);
+}
+
+TEST_CASE("Consumer drains a ConflatingBuffer as its handlers' source", "[conflating]")
+{
+    ts::ConflatingBuffer<ts::FlatTick> latest(16);
+    ts::RingBuffer<ts::FlatTick> rb(64);
+
+    // the fast consumer republishes into the conflating buffer
+    ts::Consumer<ts::FlatTick> fast;
+    fast.subscribe(std::ref(latest));
+    for (std::uint32_t s = 1; s <= 40; ++s) rb.try_push(tick(s % 4, s));
+    REQUIRE(fast.process(rb) == 40);
+
+    ts::Consumer<ts::FlatTick> slow;
+    std::vector<std::uint32_t> got;
+    slow.subscribe([&](const ts::FlatTick& t) { got.push_back(t.sequence); });
+    REQUIRE(slow.process(latest) == 4);
+    CHECK(got == std::vector<std::uint32_t>{40, 37, 38, 39});
+}
@@ -0,0 +1,205 @@
+// tests/tickstream/test_coro.cpp
+#include "catch_amalgamated.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// internal includes
+#include <tickstream/coro.hpp>
+#include <tickstream/stream_gen.hpp>
+
+namespace ts = tickstream; // local alias
+namespace co = tickstream::co;
+
+namespace {
+    ts::Params universe(std::size_t symbols) {
+        ts::Params p;
+        p.symbols.clear();
+        for (std::size_t i = 0; i < symbols; ++i) p.symbols.push_back("CO" + std::to_string(i));
+        p.seed = 5;
+        return p;
+    }
+
+    co::Task generate(ts::StreamGen& gen, co::Channel<ts::FlatTick>& out) {
+        co::TickSource source(gen, 64);
+        for (auto batch = co_await source.next(); !batch.empty(); batch = co_await source.next()) {
+            co_await out.push(batch);
+        }
+        out.close();
+    }
+
+    co::Task keep_symbol(co::Channel<ts::FlatTick>& in, co::Channel<ts::FlatTick>& out, ts::SymbolId id) {
+        std::array<ts::FlatTick, 32> buf;
+        while (std::size_t n = co_await in.pop(buf)) {
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                if (buf[i].symbol_id == id) buf[kept++] = buf[i];
+            }
+            co_await out.push(std::span<const ts::FlatTick>(buf.data(), kept));
+        }
+        out.close();
+    }
+
+    co::Task collect(co::Channel<ts::FlatTick>& in, std::vector<ts::FlatTick>& out) {
+        std::array<ts::FlatTick, 16> buf;
+        while (std::size_t n = co_await in.pop(buf)) out.insert(out.end(), buf.begin(), buf.begin() + n);
+    }
+
+    co::Task relay(co::Channel<std::uint64_t>& in, co::Channel<std::uint64_t>& out) {
+        std::array<std::uint64_t, 8> buf;
+        while (std::size_t n = co_await in.pop(buf)) co_await out.push(std::span<const std::uint64_t>(buf.data(), n));
+        out.close();
+    }
+}
+
+TEST_CASE("Generate, filter and collect stages share one thread", "[coro]")
+{
+    ts::Params params = universe(4);
+    params.max_count = 4000;
+    ts::StreamGen gen(params);
+    const ts::SymbolId id = ts::SymbolRegistry::global().intern("CO2");
+
+    co::Channel<ts::FlatTick> raw(128), filtered(16);
+    std::vector<ts::FlatTick> got;
+    co::Executor ex;
+    ex.spawn(generate(gen, raw));
+    ex.spawn(keep_symbol(raw, filtered, id));
+    ex.spawn(collect(filtered, got));
+    ex.run();
+
+    REQUIRE(ex.tasks() == 0);
+    REQUIRE(got.size() == 1000);
+    for (std::size_t i = 0; i < got.size(); ++i) {
+        REQUIRE(got[i].symbol_id == id);
+        REQUIRE(got[i].sequence == i);
+    }
+
+    // same ticks as pulling the generator directly
+    ts::StreamGen direct(params);
+    std::vector<ts::FlatTick> all(4000);
+    direct.next_batch(all);
+    REQUIRE(got.back().price == all[4 * 999 + 2].price);
+}
+
+TEST_CASE("Hundreds of stages run on one executor", "[coro]")
+{
+    const std::size_t stages = 300;
+    const std::uint64_t items = 20000;
+
+    std::vector<std::unique_ptr<co::Channel<std::uint64_t>>> pipes;
+    for (std::size_t i = 0; i <= stages; ++i) pipes.push_back(std::make_unique<co::Channel<std::uint64_t>>(16));
+
+    std::uint64_t sum = 0, count = 0;
+    bool ordered = true;
+    co::Executor ex;
+    ex.spawn([](co::Channel<std::uint64_t>& out, std::uint64_t n) -> co::Task {
+        for (std::uint64_t i = 0; i < n; ++i) co_await out.push(std::span<const std::uint64_t>(&i, 1));
+        out.close();
+    }(*pipes.front(), items));
+    for (std::size_t i = 0; i < stages; ++i) ex.spawn(relay(*pipes[i], *pipes[i + 1]));
+    ex.spawn([](co::Channel<std::uint64_t>& in, std::uint64_t& sum, std::uint64_t& count, bool& ordered) -> co::Task {
+        std::array<std::uint64_t, 64> buf;
+        while (std::size_t n = co_await in.pop(buf)) {
+            for (std::size_t i = 0; i < n; ++i) {
+                ordered = ordered && buf[i] == count;
+                sum += buf[i];
+                ++count;
+            }
+        }
+    }(*pipes.back(), sum, count, ordered));
+    ex.run();
+
+    REQUIRE(count == items);
+    REQUIRE(ordered);
+    REQUIRE(sum == items * (items - 1) / 2);
+}
+
+TEST_CASE("A paced TickSource follows the generator rate", "[coro]")
+{
+    ts::Params params = universe(2);
+    params.rate_hz = 500.0; // one step of 2 ticks every 2 ms
+    params.max_count = 40;
+    ts::StreamGen gen(params);
+
+    std::uint64_t received = 0;
+    co::Executor ex;
+    ex.spawn([](ts::StreamGen& gen, std::uint64_t& received) -> co::Task {
+        co::TickSource source(gen, 0, true);
+        for (auto batch = co_await source.next(); !batch.empty(); batch = co_await source.next()) {
+            received += batch.size();
+        }
+    }(gen, received));
+
+    const auto t0 = std::chrono::steady_clock::now();
+    ex.run();
+    const auto elapsed = std::chrono::steady_clock::now() - t0;
+
+    REQUIRE(received == 40);
+    REQUIRE(elapsed >= std::chrono::milliseconds(38)); // 20 steps, the first one immediate
+}
+
+TEST_CASE("stop() releases parked and sleeping stages", "[coro]")
+{
+    co::Channel<int> never(4);
+    co::Executor ex;
+    bool pop_done = false, sleep_done = false;
+    ex.spawn([](co::Channel<int>& in, bool& done) -> co::Task {
+        std::array<int, 4> buf;
+        done = (co_await in.pop(buf)) == 0;
+    }(never, pop_done));
+    ex.spawn([](bool& done) -> co::Task {
+        co_await co::sleep_for(std::chrono::hours(1));
+        done = true;
+    }(sleep_done));
+
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ex.stop();
+    });
+    ex.run();
+    stopper.join();
+
+    REQUIRE(pop_done);
+    REQUIRE(sleep_done);
+}
+
+TEST_CASE("Channels connect coroutines to plain threads", "[coro]")
+{
+    co::Channel<int> pipe(64);
+    std::thread producer([&] {
+        for (int i = 1; i <= 10000; ++i) {
+            while (!pipe.ring().try_push(i)) std::this_thread::yield();
+        }
+        pipe.close();
+    });
+
+    long long sum = 0;
+    co::Executor ex;
+    ex.spawn([](co::Channel<int>& in, long long& sum) -> co::Task {
+        std::array<int, 128> buf;
+        while (std::size_t n = co_await in.pop(buf)) {
+            for (std::size_t i = 0; i < n; ++i) sum += buf[i];
+        }
+    }(pipe, sum));
+    ex.run();
+    producer.join();
+
+    REQUIRE(sum == 10000LL * 10001 / 2);
+}
+
+TEST_CASE("Exceptions escaping a stage surface from run()", "[coro]")
+{
+    co::Executor ex;
+    ex.spawn([]() -> co::Task {
+        co_await co::yield();
+        throw std::runtime_error("stage failed");
+    }());
+    REQUIRE_THROWS_WITH(ex.run(), "stage failed");
+    REQUIRE(co::Executor::current() == nullptr);
+}
@@ -0,0 +1,157 @@
+// tests/tickstream/test_correlation.cpp
+#include "catch_amalgamated.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <tickstream/model.hpp>
+
+namespace ts = tickstream; // local alias
+
+namespace {
+    using Shocks = ts::Model<ts::OU, ts::Correlated>;
+
+    // kappa = 0 and constant vol: level increments are sigma*sqrt(dt) times the shocks
+    ts::Params random_walk() {
+        ts::Params p;
+        p.seed = 21;
+        p.kappa = 0.0;
+        return p;
+    }
+
+    // sample correlation matrix of level increments over `steps` steps
+    std::vector<double> sample_correlation(Shocks& m, int steps) {
+        const std::size_t n = m.size();
+        std::vector<double> prev = m.level(), sum(n, 0.0), cross(n * n, 0.0);
+        for (int s = 0; s < steps; ++s) {
+            m.step();
+            std::vector<double> d(n);
+            for (std::size_t i = 0; i < n; ++i) d[i] = m.level()[i] - prev[i];
+            prev = m.level();
+            for (std::size_t i = 0; i < n; ++i) {
+                sum[i] += d[i];
+                for (std::size_t j = 0; j < n; ++j) cross[i * n + j] += d[i] * d[j];
+            }
+        }
+        std::vector<double> corr(n * n);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                const auto cov = [&](std::size_t a, std::size_t b) { return cross[a * n + b] / steps - sum[a] * sum[b] / (double(steps) * steps); };
+                corr[i * n + j] = cov(i, j) / std::sqrt(cov(i, i) * cov(j, j));
+            }
+        }
+        return corr;
+    }
+}
+
+TEST_CASE("Factor loadings set the cross-sectional correlation", "[correlation]")
+{
+    ts::Params params = random_walk();
+    params.factor_count = 2;
+    params.factor_loadings = {0.9, 0.0,
+                              0.9, 0.0,
+                              -0.5, 0.5,
+                              0.0, 0.0};
+    Shocks m(params, 4, params.seed);
+    const auto c = sample_correlation(m, 20000);
+
+    REQUIRE(c[0 * 4 + 1] == Catch::Approx(0.81).margin(0.03));
+    REQUIRE(c[0 * 4 + 2] == Catch::Approx(-0.45).margin(0.03));
+    REQUIRE(c[1 * 4 + 2] == Catch::Approx(-0.45).margin(0.03));
+    for (std::size_t i = 0; i < 3; ++i) REQUIRE(c[i * 4 + 3] == Catch::Approx(0.0).margin(0.03));
+}
+
+TEST_CASE("A correlation matrix is reproduced through its Cholesky factor", "[correlation]")
+{
+    ts::Params params = random_walk();
+    params.correlation = {1.0, 0.6, 0.3,
+                          0.6, 1.0, 0.5,
+                          0.3, 0.5, 1.0};
+    Shocks m(params, 3, params.seed);
+    const auto c = sample_correlation(m, 20000);
+
+    for (std::size_t i = 0; i < 9; ++i) REQUIRE(c[i] == Catch::Approx(params.correlation[i]).margin(0.03));
+}
+
+TEST_CASE("Correlated paths do not depend on how symbols are sharded", "[correlation]")
+{
+    const std::size_t n = 600; // spans several row blocks
+    ts::Params factor = random_walk();
+    factor.factor_count = 3;
+    ts::Params full = random_walk();
+    full.correlation.assign(n * n, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t f = 0; f < 3; ++f) factor.factor_loadings.push_back(0.1 * double((i + f) % 5));
+        for (std::size_t j = 0; j < n; ++j) full.correlation[i * n + j] = i == j ? 1.0 : 0.4;
+    }
+
+    for (const ts::Params* params : {&factor, &full}) {
+        Shocks whole(*params, n, params->seed);
+        Shocks shard(*params, 300, params->seed, 290); // symbols 290..589
+        for (int step = 0; step < 20; ++step) {
+            whole.step();
+            shard.step();
+            for (std::size_t i = 0; i < shard.size(); ++i) REQUIRE(whole.level()[290 + i] == shard.level()[i]);
+        }
+    }
+}
+
+TEST_CASE("Invalid correlation inputs are rejected", "[correlation]")
+{
+    ts::Params params = random_walk();
+
+    SECTION("both forms") {
+        params.factor_count = 1;
+        params.factor_loadings = {0.5, 0.5};
+        params.correlation = {1.0, 0.0, 0.0, 1.0};
+        REQUIRE_THROWS_AS(Shocks(params, 2, 1), std::invalid_argument);
+    }
+    SECTION("loading norm above one") {
+        params.factor_count = 2;
+        params.factor_loadings = {0.8, 0.8};
+        REQUIRE_THROWS_AS(Shocks(params, 1, 1), std::invalid_argument);
+    }
+    SECTION("too few rows") {
+        params.factor_count = 1;
+        params.factor_loadings = {0.5, 0.5};
+        REQUIRE_THROWS_AS(Shocks(params, 3, 1), std::invalid_argument);
+    }
+    SECTION("not positive semi-definite") {
+        params.correlation = {1.0, 0.9, -0.9,
+                              0.9, 1.0, 0.9,
+                              -0.9, 0.9, 1.0};
+        REQUIRE_THROWS_AS(Shocks(params, 3, 1), std::invalid_argument);
+    }
+    SECTION("asymmetric") {
+        params.correlation = {1.0, 0.2, 0.3, 1.0};
+        REQUIRE_THROWS_AS(Shocks(params, 2, 1), std::invalid_argument);
+    }
+}
+
+TEST_CASE("set_params refactorizes only when the correlation inputs change", "[correlation]")
+{
+    ts::Params params = random_walk();
+    params.correlation = {1.0, 0.6, 0.3,
+                          0.6, 1.0, 0.5,
+                          0.3, 0.5, 1.0};
+    Shocks m(params, 3, params.seed);
+
+    params.rate_hz *= 4.0; // scalars only: the factor is kept
+    m.set_params(params);
+    auto c = sample_correlation(m, 20000);
+    for (std::size_t i = 0; i < 9; ++i) REQUIRE(c[i] == Catch::Approx(params.correlation[i]).margin(0.03));
+
+    params.correlation = {1.0, 0.0, -0.4,
+                          0.0, 1.0, 0.0,
+                          -0.4, 0.0, 1.0};
+    m.set_params(params);
+    c = sample_correlation(m, 20000);
+    for (std::size_t i = 0; i < 9; ++i) REQUIRE(c[i] == Catch::Approx(params.correlation[i]).margin(0.03));
+
+    params.correlation = {1.0, 0.9, -0.9,
+                          0.9, 1.0, 0.9,
+                          -0.9, 0.9, 1.0};
+    REQUIRE_THROWS_AS(m.set_params(params), std::invalid_argument);
+}
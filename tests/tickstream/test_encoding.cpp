@@ -0,0 +1,191 @@
+// tests/tickstream/test_encoding.cpp
+#include "catch_amalgamated.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// internal includes
+#include <tickstream/encoding.hpp>
+#include <tickstream/stream_gen.hpp>
+
+namespace ts = tickstream; // local alias
+
+namespace {
+    std::string temp_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::string slurp(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    std::vector<ts::FlatTick> sample(std::size_t n) {
+        ts::Params params;
+        params.symbols = {"ENC-A", "ENC-B", "ENC-C"};
+        params.seed = 17;
+        ts::StreamGen gen(params);
+        std::vector<ts::FlatTick> ticks(n);
+        gen.next_batch(ticks);
+        return ticks;
+    }
+
+    std::vector<std::string> fields(const std::string& line) {
+        std::vector<std::string> out;
+        std::stringstream ss(line);
+        for (std::string f; std::getline(ss, f, ',');) out.push_back(f);
+        return out;
+    }
+
+    template<typename T>
+    T parse(std::string_view s) {
+        T v{};
+        const auto r = std::from_chars(s.data(), s.data() + s.size(), v);
+        REQUIRE(r.ec == std::errc{});
+        REQUIRE(r.ptr == s.data() + s.size());
+        return v;
+    }
+
+    // value of "key": in a JSON line, up to the next ',' or '}'
+    std::string_view json_value(std::string_view line, std::string_view key) {
+        const std::string needle = "\"" + std::string(key) + "\":";
+        const std::size_t at = line.find(needle);
+        REQUIRE(at != std::string_view::npos);
+        const std::size_t begin = at + needle.size();
+        return line.substr(begin, line.find_first_of(",}", begin) - begin);
+    }
+}
+
+TEST_CASE("CSV output round-trips every field exactly", "[encoding]")
+{
+    const auto ticks = sample(3000);
+    const auto path = temp_path("tickstream_encoding.csv");
+    {
+        ts::TickWriter writer(path, ts::Format::Csv, 4096); // forces many flushes
+        writer.write(ticks);
+        REQUIRE(writer.ticks() == ticks.size());
+    }
+
+    std::stringstream in(slurp(path));
+    std::string line;
+    std::getline(in, line);
+    REQUIRE(line + "\n" == ts::encoding::csv_header);
+
+    for (const auto& t : ticks) {
+        REQUIRE(std::getline(in, line));
+        const auto f = fields(line);
+        REQUIRE(f.size() == 8);
+        REQUIRE(f[0] == ts::SymbolRegistry::global().name(t.symbol_id));
+        REQUIRE(parse<double>(f[1]) == t.price);
+        REQUIRE(parse<double>(f[2]) == t.volume);
+        REQUIRE(parse<double>(f[3]) == t.bid);
+        REQUIRE(parse<double>(f[4]) == t.ask);
+        REQUIRE(parse<std::uint64_t>(f[5]) == t.unix_ts_ns);
+        REQUIRE(parse<std::uint64_t>(f[6]) == t.mono_ts_ns);
+        REQUIRE(parse<std::uint32_t>(f[7]) == t.sequence);
+    }
+    REQUIRE_FALSE(std::getline(in, line));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("JSON lines carry the same fields", "[encoding]")
+{
+    const auto ticks = sample(300);
+    const auto path = temp_path("tickstream_encoding.jsonl");
+    {
+        ts::TickWriter writer(path, ts::Format::JsonLines);
+        for (const auto& t : ticks) writer(t);
+    }
+
+    std::stringstream in(slurp(path));
+    std::string line;
+    for (const auto& t : ticks) {
+        REQUIRE(std::getline(in, line));
+        REQUIRE(line.front() == '{');
+        REQUIRE(line.back() == '}');
+        REQUIRE(json_value(line, "symbol") == "\"" + std::string(ts::SymbolRegistry::global().name(t.symbol_id)) + "\"");
+        REQUIRE(parse<double>(json_value(line, "price")) == t.price);
+        REQUIRE(parse<double>(json_value(line, "ask")) == t.ask);
+        REQUIRE(parse<std::uint64_t>(json_value(line, "mono_ts_ns")) == t.mono_ts_ns);
+        REQUIRE(parse<std::uint32_t>(json_value(line, "sequence")) == t.sequence);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Symbol names are escaped per format", "[encoding]")
+{
+    ts::SymbolRegistry registry;
+    ts::FlatTick t{};
+    t.price = 1.5;
+    t.symbol_id = registry.intern("A,\"B\"");
+
+    const auto path = temp_path("tickstream_encoding_escape.txt");
+    {
+        ts::TickWriter writer(path, ts::Format::Csv, 1 << 16, registry);
+        writer.write(t);
+    }
+    REQUIRE(slurp(path).find("\n\"A,\"\"B\"\"\",1.5,") != std::string::npos);
+    {
+        ts::TickWriter writer(path, ts::Format::JsonLines, 1 << 16, registry);
+        writer.write(t);
+    }
+    REQUIRE(slurp(path).rfind("{\"symbol\":\"A,\\\"B\\\"\",\"price\":1.5,", 0) == 0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary frames decode back to the same ticks", "[encoding]")
+{
+    const auto ticks = sample(2000);
+    const auto path = temp_path("tickstream_encoding.bin");
+    {
+        ts::TickWriter writer(path, ts::Format::Binary, 1000);
+        writer.write(ticks);
+        writer.close();
+        REQUIRE(writer.bytes() == 8 + 3 * (4 + 4 + 5) + ticks.size() * (4 + sizeof(ts::encoding::TickRecord)));
+    }
+    const std::string data = slurp(path);
+
+    // decode in awkward chunk sizes, as a reader of a pipe would see them
+    ts::SymbolRegistry registry;
+    ts::BinaryDecoder decoder(registry);
+    std::vector<ts::FlatTick> out;
+    std::string pending;
+    for (std::size_t at = 0; at < data.size(); at += 37) {
+        pending.append(data, at, 37);
+        const std::size_t used = decoder.decode(pending, [&](const ts::FlatTick& t) { out.push_back(t); });
+        pending.erase(0, used);
+    }
+    REQUIRE(pending.empty());
+
+    REQUIRE(out.size() == ticks.size());
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        REQUIRE(registry.name(out[i].symbol_id) == ts::SymbolRegistry::global().name(ticks[i].symbol_id));
+        REQUIRE(out[i].price == ticks[i].price);
+        REQUIRE(out[i].volume == ticks[i].volume);
+        REQUIRE(out[i].bid == ticks[i].bid);
+        REQUIRE(out[i].ask == ticks[i].ask);
+        REQUIRE(out[i].unix_ts_ns == ticks[i].unix_ts_ns);
+        REQUIRE(out[i].mono_ts_ns == ticks[i].mono_ts_ns);
+        REQUIRE(out[i].sequence == ticks[i].sequence);
+    }
+    std::filesystem::remove(path);
+
+    ts::BinaryDecoder strict(registry);
+    REQUIRE_THROWS_AS(strict.decode(std::string_view("NOPE\1\0\0\0", 8), [](const ts::FlatTick&) {}), std::runtime_error);
+}
+
+TEST_CASE("Formats are parsed by name", "[encoding]")
+{
+    REQUIRE(ts::parse_format("csv") == ts::Format::Csv);
+    REQUIRE(ts::parse_format("jsonl") == ts::Format::JsonLines);
+    REQUIRE(ts::parse_format("binary") == ts::Format::Binary);
+    REQUIRE_THROWS_AS(ts::parse_format("xml"), std::invalid_argument);
+}
@@ -0,0 +1,130 @@
+// tests/tickstream/test_lane_merger.cpp
+#include "catch_amalgamated.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+// internal includes
+#include <tickstream/consumer.hpp>
+#include <tickstream/lane_merger.hpp>
+#include <tickstream/stream.hpp>
+
+namespace ts = tickstream; // local alias
+using namespace std::chrono_literals;
+
+namespace {
+    ts::FlatTick at(std::uint64_t ts, std::uint32_t symbol) {
+        ts::FlatTick t{};
+        t.mono_ts_ns = ts;
+        t.symbol_id = symbol;
+        return t;
+    }
+}
+
+TEST_CASE("LaneMerger yields lane heads in timestamp order", "[lane_merger]")
+{
+    ts::RingBuffer<ts::FlatTick> a(16), b(16), c(16);
+    ts::LaneMerger<ts::FlatTick> merger;
+    merger.add_lane(a);
+    merger.add_lane(b);
+    merger.add_lane(c);
+
+    for (std::uint64_t t : {10, 40, 70}) a.try_push(at(t, 0));
+    for (std::uint64_t t : {20, 50, 80}) b.try_push(at(t, 1));
+    for (std::uint64_t t : {30, 40, 90}) c.try_push(at(t, 2));
+    REQUIRE(merger.size() == 9);
+
+    std::vector<std::uint32_t> order;
+    // lane a drains at 70 and lane c still holds 90 at that point: nothing held back with a zero window
+    REQUIRE(merger.poll([&](const ts::FlatTick& t) { order.push_back(t.symbol_id); }, 0) == 9);
+    CHECK(order == std::vector<std::uint32_t>{0, 1, 2, 0, 2, 1, 0, 1, 2}); // tie at 40 goes to the lower lane
+    CHECK(merger.empty());
+    CHECK(merger.late() == 0);
+}
+
+TEST_CASE("LaneMerger holds back ticks while a lane is empty, within the window", "[lane_merger]")
+{
+    ts::RingBuffer<ts::FlatTick> a(16), b(16);
+    ts::LaneMerger<ts::FlatTick> merger(100ns);
+    merger.add_lane(a);
+    merger.add_lane(b);
+
+    std::vector<std::uint64_t> out;
+    const auto sink = [&](const ts::FlatTick& t) { out.push_back(t.mono_ts_ns); };
+
+    a.try_push(at(1000, 0));
+    CHECK(merger.poll(sink, 1050) == 0);        // b might still send something earlier
+    b.try_push(at(990, 1));                     // ...and it does
+    CHECK(merger.poll(sink, 1060) == 1);        // both staged: 990 goes; a's 1000 waits on empty b
+    CHECK(merger.poll(sink, 1100) == 1);        // window elapsed
+    CHECK(out == std::vector<std::uint64_t>{990, 1000});
+
+    b.try_push(at(900, 1));                     // arrived after the window: passed through, counted late
+    CHECK(merger.poll(sink, 2000) == 1);
+    CHECK(merger.late() == 1);
+
+    a.try_push(at(3000, 0));
+    CHECK(merger.poll(sink, 3000) == 0);
+    CHECK(merger.release_at_ns() == 3100);      // when the held tick becomes due
+    CHECK(merger.flush(sink) == 1);
+    CHECK(merger.release_at_ns() == std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST_CASE("Consumer releases held-back ticks once the reorder window elapses", "[lane_merger]")
+{
+    ts::RingBuffer<ts::FlatTick> a(16), b(16);
+    ts::LaneMerger<ts::FlatTick> merger(20ms);
+    merger.add_lane(a);
+    merger.add_lane(b);
+
+    ts::Consumer<ts::FlatTick> consumer;
+    std::atomic<int> seen{0};
+    consumer.subscribe([&](const ts::FlatTick&) { ++seen; });
+    std::atomic<bool> running{true};
+
+    a.try_push(at(ts::StreamStats::now_ns(), 0)); // b stays empty: held for the window
+    std::thread t([&] { consumer.process_continuous(merger, running); });
+    std::this_thread::sleep_for(5ms);
+    CHECK(seen.load() == 0);
+    std::this_thread::sleep_for(40ms);
+    CHECK(seen.load() == 1);
+
+    running = false;
+    t.join();
+}
+
+TEST_CASE("TickStream lanes stay SPSC with several scheduler threads", "[lane_merger]")
+{
+    ts::Scheduler::Options scheduling;
+    scheduling.threads = 3;
+    ts::TickStream stream(256, scheduling);
+    for (int i = 0; i < 6; ++i) stream.add_symbol("L" + std::to_string(i), ts::tick_btc, 1ms);
+    CHECK_THROWS_AS(stream.add_symbol("L0", ts::tick_btc, 1ms), std::invalid_argument);
+
+    ts::Consumer<ts::Tick> consumer;
+    consumer.set_stats(stream.stream_stats());
+    consumer.set_wait_strategy(stream.wait_strategy());
+    std::uint64_t last = 0, inversions = 0;
+    consumer.subscribe([&](const ts::Tick& t) {
+        if (t.mono_ts_ns < last) ++inversions;
+        last = std::max(last, t.mono_ts_ns);
+    });
+
+    std::atomic<bool> running{true};
+    std::thread t([&] { consumer.process_continuous(stream.merger(), running); });
+    stream.start();
+    std::this_thread::sleep_for(50ms);
+    stream.stop();
+    running = false;
+    stream.wait_strategy().wake_all();
+    t.join();
+
+    const auto stats = stream.get_stats();
+    REQUIRE(stats.total_ticks_produced > 0);
+    CHECK(stats.total_ticks_consumed == stats.total_ticks_produced - stats.buffer_drops);
+    CHECK(inversions == stream.merger().late());
+}
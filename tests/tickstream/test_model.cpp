@@ -0,0 +1,155 @@
+// tests/tickstream/test_model.cpp
+#include "catch_amalgamated.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <tickstream/model.hpp>
+#include <tickstream/stream_gen.hpp>
+
+namespace ts = tickstream; // local alias
+
+namespace {
+    ts::Params busy_params() {
+        ts::Params p;
+        p.symbols = {"A", "B", "C", "D", "E"};
+        p.seed = 99;
+        p.lambda_jump = 50;
+        p.p01 = 0.2;
+        p.p10 = 0.3;
+        return p;
+    }
+
+    // FNV-1a over price, volume, bid, ask
+    std::uint64_t hash_quotes(const std::vector<ts::FlatTick>& ticks) {
+        std::uint64_t h = 1469598103934665603ull;
+        for (const auto& t : ticks) {
+            unsigned char b[4 * sizeof(double)];
+            const double q[4] = {t.price, t.volume, t.bid, t.ask};
+            std::memcpy(b, q, sizeof(b));
+            for (auto c : b) { h ^= c; h *= 1099511628211ull; }
+        }
+        return h;
+    }
+}
+
+TEST_CASE("Default composition reproduces the fixed engine's paths", "[model]")
+{
+    ts::StreamGen gen(busy_params());
+    std::vector<ts::FlatTick> ticks(50000);
+    gen.next_batch(ticks);
+    // recorded before the engine was split into components
+    REQUIRE(hash_quotes(ticks) == 0x5a22dcefede4da5full);
+
+    auto same = ts::StreamGen::with_model<ts::DefaultModel>(busy_params());
+    std::vector<ts::FlatTick> again(ticks.size());
+    same.next_batch(again);
+    REQUIRE(hash_quotes(again) == hash_quotes(ticks));
+}
+
+TEST_CASE("Omitted components leave the other draws in place", "[model]")
+{
+    ts::Params params = busy_params();
+    params.lambda_jump = 0.0;
+
+    ts::DefaultModel full(params, 8, params.seed);
+    ts::Model<ts::RegimeSwitch<2>, ts::OU> lean(params, 8, params.seed); // any order
+
+    for (int step = 0; step < 200; ++step) {
+        full.step();
+        lean.step();
+        for (std::size_t i = 0; i < 8; ++i) {
+            REQUIRE(full.level()[i] == lean.level()[i]);
+            REQUIRE(full.regime()[i] == lean.regime()[i]);
+            REQUIRE(full.volume()[i] == lean.volume()[i]);
+            // no microstructure: quoted at the level, off the tick grid
+            REQUIRE(lean.price()[i] == lean.level()[i]);
+            REQUIRE(lean.ask()[i] - lean.bid()[i] == Catch::Approx(2 * params.tick_size));
+        }
+    }
+}
+
+TEST_CASE("GBM with constant volatility follows its drift", "[model]")
+{
+    ts::Params params;
+    params.mu = 50.0;
+    params.drift = 0.2;
+    params.sigma0 = 0.0;
+
+    ts::Model<ts::GBM> flat(params, 4, 1);
+    for (int step = 0; step < 100; ++step) flat.step();
+    const double expected = 50.0 * std::exp(0.2 * 100 * flat.dt());
+    for (double x : flat.level()) REQUIRE(x == Catch::Approx(expected).epsilon(1e-12));
+
+    params.sigma0 = 0.3;
+    params.drift = 0.0;
+    ts::Model<ts::GBM, ts::Jumps, ts::Microstructure> noisy(params, 256, 2);
+    double mean_log = 0.0;
+    for (int step = 0; step < 400; ++step) noisy.step();
+    for (std::size_t i = 0; i < noisy.size(); ++i) {
+        REQUIRE(noisy.level()[i] > 0.0);
+        mean_log += std::log(noisy.level()[i] / 50.0) / static_cast<double>(noisy.size());
+    }
+    // E[log S_T/S_0] = -sigma^2 T / 2 (jumps are zero-mean in log)
+    const double t = 400 * noisy.dt();
+    REQUIRE(std::abs(mean_log + 0.5 * 0.09 * t) < 4.0 * 0.3 * std::sqrt(t / 256.0) + 0.05);
+}
+
+TEST_CASE("N-state regime switching uses the transition table", "[model]")
+{
+    ts::Params params;
+    params.regime_sigmas = {0.1, 0.2, 0.4};
+
+    SECTION("deterministic cycle 0 -> 1 -> 2 -> 0") {
+        params.regime_transitions = {0, 1, 0,
+                                     0, 0, 1,
+                                     1, 0, 0};
+        ts::Model<ts::OU, ts::RegimeSwitch<3>> m(params, 5, 3);
+        for (int step = 1; step <= 9; ++step) {
+            m.step();
+            for (double r : m.regime()) REQUIRE(r == static_cast<double>(step % 3));
+        }
+    }
+
+    SECTION("occupancy matches the stationary distribution") {
+        // uniform rows => stationary distribution is uniform
+        params.regime_transitions = {0.5, 0.25, 0.25,
+                                     0.25, 0.5, 0.25,
+                                     0.25, 0.25, 0.5};
+        ts::Model<ts::OU, ts::RegimeSwitch<3>> m(params, 64, 4);
+        double counts[3]{};
+        for (int step = 0; step < 500; ++step) {
+            m.step();
+            for (double r : m.regime()) counts[static_cast<int>(r)] += 1.0;
+        }
+        for (double c : counts) REQUIRE(c / (500.0 * 64.0) == Catch::Approx(1.0 / 3.0).margin(0.02));
+    }
+
+    SECTION("table shape is validated") {
+        params.regime_transitions = {0.5, 0.5, 1.0};
+        using M = ts::Model<ts::OU, ts::RegimeSwitch<3>>;
+        REQUIRE_THROWS_AS(M(params, 1, 1), std::invalid_argument);
+        params.regime_sigmas.clear();
+        params.regime_transitions.clear();
+        REQUIRE_THROWS_AS(M(params, 1, 1), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Two-state switching accepts the table form", "[model]")
+{
+    ts::Params params = busy_params();
+    ts::Params table = params;
+    table.regime_sigmas = {params.sigma0, params.sigma1};
+    table.regime_transitions = {1.0 - params.p01, params.p01,
+                                params.p10, 1.0 - params.p10};
+
+    ts::DefaultModel a(params, 4, params.seed), b(table, 4, table.seed);
+    for (int step = 0; step < 100; ++step) {
+        a.step();
+        b.step();
+        for (std::size_t i = 0; i < 4; ++i) REQUIRE(a.price()[i] == b.price()[i]);
+    }
+}
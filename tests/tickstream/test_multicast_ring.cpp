@@ -0,0 +1,146 @@
+// tests/tickstream/test_multicast_ring.cpp
+#include "catch_amalgamated.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// internal includes
+#include <tickstream/multicast_ring.hpp>
+#include <tickstream/consumer.hpp>
+
+namespace ts = tickstream; // local alias
+
+TEST_CASE("MulticastRing delivers every element to every reader", "[multicast]")
+{
+    ts::MulticastRing<int> ring(4);
+    ts::MulticastReader<int> a(ring), b(ring);
+
+    for (int i = 0; i < 4; ++i) REQUIRE(ring.try_publish(i));
+    REQUIRE_FALSE(ring.try_publish(4)); // gated on both readers
+
+    std::vector<int> seen_a;
+    REQUIRE(a.poll([&](const int& v, std::int64_t, bool) { seen_a.push_back(v); }) == 4);
+    REQUIRE(seen_a == std::vector<int>{0, 1, 2, 3});
+    REQUIRE_FALSE(ring.try_publish(4)); // b still holds the ring
+
+    REQUIRE(b.poll([](const int&, std::int64_t, bool) {}, 2) == 2);
+    REQUIRE(ring.try_publish(4));
+    REQUIRE(ring.try_publish(5));
+    REQUIRE_FALSE(ring.try_publish(6));
+}
+
+TEST_CASE("MulticastReader dependency barrier trails its upstream stage", "[multicast]")
+{
+    ts::MulticastRing<int> ring(8);
+    ts::MulticastReader<int> upstream(ring);
+    ts::MulticastReader<int> downstream(ring, {&upstream.sequence()});
+
+    REQUIRE(ring.try_publish(1));
+    REQUIRE(ring.try_publish(2));
+    REQUIRE(downstream.poll([](const int&, std::int64_t, bool) {}) == 0);
+
+    REQUIRE(upstream.poll([](const int&, std::int64_t, bool) {}, 1) == 1);
+    REQUIRE(downstream.poll([](const int&, std::int64_t, bool) {}) == 1);
+}
+
+TEST_CASE("MulticastRing fans out across threads with a dependent stage", "[multicast]")
+{
+    constexpr std::int64_t count = 100000;
+    ts::MulticastRing<std::int64_t> ring(256);
+    ts::MulticastReader<std::int64_t> strategy(ring), recorder(ring);
+    ts::MulticastReader<std::int64_t> risk(ring, {&strategy.sequence()});
+
+    auto run = [&](ts::MulticastReader<std::int64_t>& reader, std::int64_t& sum, bool& ordered,
+                   const ts::Sequence* upstream) {
+        std::int64_t expected = 0;
+        while (expected < count) {
+            const auto n = reader.poll([&](const std::int64_t& v, std::int64_t seq, bool) {
+                ordered &= (v == expected++);
+                if (upstream) ordered &= (upstream->get() >= seq);
+                sum += v;
+            });
+            if (n == 0) std::this_thread::yield();
+        }
+    };
+
+    std::int64_t sums[3] = {};
+    bool ordered[3] = {true, true, true};
+    std::thread t0([&] { run(strategy, sums[0], ordered[0], nullptr); });
+    std::thread t1([&] { run(recorder, sums[1], ordered[1], nullptr); });
+    std::thread t2([&] { run(risk, sums[2], ordered[2], &strategy.sequence()); });
+
+    for (std::int64_t i = 0; i < count; ++i) {
+        while (!ring.try_publish(i)) std::this_thread::yield();
+    }
+    t0.join();
+    t1.join();
+    t2.join();
+
+    const std::int64_t expected = count * (count - 1) / 2;
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(ordered[i]);
+        REQUIRE(sums[i] == expected);
+    }
+}
+
+TEST_CASE("Consumer processes its own multicast cursor", "[multicast]")
+{
+    ts::MulticastRing<int> ring(8);
+    ts::MulticastReader<int> ra(ring), rb(ring);
+    ts::Consumer<int> a, b;
+    int sum_a = 0, sum_b = 0;
+    a.subscribe([&](const int& v) { sum_a += v; });
+    b.subscribe([&](const int& v) { sum_b += v; });
+
+    for (int i = 1; i <= 5; ++i) REQUIRE(ring.try_publish(i));
+    REQUIRE(a.process(ra) == 5);
+    REQUIRE(a.process(ra) == 0);
+    REQUIRE(b.process(rb) == 5);
+    REQUIRE(sum_a == 15);
+    REQUIRE(sum_b == 15);
+}
+
+TEST_CASE("MulticastReaders may join and leave while the producer publishes", "[multicast]")
+{
+    ts::MulticastRing<std::int64_t> ring(64, 2);
+    ts::MulticastReader<std::int64_t> first(ring);
+    {
+        ts::MulticastReader<std::int64_t> second(ring);
+        REQUIRE_THROWS_AS(ts::MulticastReader<std::int64_t>(ring), std::length_error); // max_readers = 2
+    }
+
+    constexpr std::int64_t count = 100000;
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (std::int64_t i = 0; i < count; ++i) {
+            while (!ring.try_publish(i)) std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    const auto drain = [&](ts::MulticastReader<std::int64_t>& reader, std::int64_t stop_after) {
+        bool ordered = true;
+        std::int64_t expected = -1, seen = 0;
+        while (seen < stop_after && !(done && reader.sequence().get() == ring.cursor().get())) {
+            const auto n = reader.poll([&](const std::int64_t& v, std::int64_t seq, bool) {
+                ordered = ordered && v == seq && (expected < 0 || v == expected);
+                expected = v + 1;
+                ++seen;
+            });
+            if (n == 0) std::this_thread::yield();
+        }
+        return ordered;
+    };
+
+    std::thread late([&] {
+        for (int round = 0; round < 50; ++round) {
+            ts::MulticastReader<std::int64_t> reader(ring); // joins mid-stream, leaves after a while
+            if (!drain(reader, 1000)) return;
+        }
+    });
+    CHECK(drain(first, count));
+    producer.join();
+    late.join();
+    CHECK(first.sequence().get() == count - 1);
+}
@@ -0,0 +1,129 @@
+// tests/tickstream/test_offline.cpp
+#include "catch_amalgamated.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// internal includes
+#include <tickstream/offline.hpp>
+
+namespace ts = tickstream; // local alias
+
+namespace {
+    ts::Params universe(std::size_t n) {
+        ts::Params params;
+        params.symbols.clear();
+        for (std::size_t i = 0; i < n; ++i) params.symbols.push_back("OFF" + std::to_string(i));
+        params.seed = 11;
+        params.rate_hz = 1000.0;
+        params.latency_jitter_ms = 0.5;
+        return params;
+    }
+
+    bool identical(const std::vector<ts::FlatTick>& a, const std::vector<ts::FlatTick>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(ts::FlatTick)) == 0;
+    }
+}
+
+TEST_CASE("Offline generation is bit-identical across threads, shards and windows", "[offline]")
+{
+    const auto params = universe(37);
+
+    ts::OfflineOptions base;
+    base.steps = 300;
+    base.threads = 1;
+    base.symbols_per_shard = 37;
+    base.steps_per_window = 300;
+    const auto reference = ts::generate_offline(params, base);
+    REQUIRE(reference.size() == 37 * 300);
+
+    ts::OfflineOptions split = base;
+    split.threads = 3;
+    split.symbols_per_shard = 8;
+    split.steps_per_window = 64;
+    CHECK(identical(reference, ts::generate_offline(params, split)));
+
+    split.symbols_per_shard = 1;
+    split.steps_per_window = 7;
+    CHECK(identical(reference, ts::generate_offline(params, split)));
+}
+
+TEST_CASE("Offline output is time-ordered on the simulated clock", "[offline]")
+{
+    const auto params = universe(10);
+    ts::OfflineOptions opts;
+    opts.steps = 200;
+    opts.start_unix_ns = 1'700'000'000'000'000'000ull;
+    opts.symbols_per_shard = 3;
+    opts.steps_per_window = 16;
+
+    std::size_t runs = 0;
+    std::vector<ts::FlatTick> all;
+    ts::generate_offline(params, opts, [&](std::span<const ts::FlatTick> run) {
+        ++runs;
+        all.insert(all.end(), run.begin(), run.end());
+    });
+    CHECK(runs == (200 + 15) / 16);
+    REQUIRE(all.size() == 10 * 200);
+
+    std::vector<std::uint32_t> next_seq(10, 0);
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        const auto& t = all[i];
+        if (i > 0) REQUIRE(all[i - 1].mono_ts_ns <= t.mono_ts_ns);
+        CHECK(t.unix_ts_ns == opts.start_unix_ns + t.mono_ts_ns);
+
+        // per symbol: steps in order, each stamped within its own dt slot
+        const std::size_t s = std::stoul(std::string(ts::SymbolRegistry::global().name(t.symbol_id).substr(3)));
+        REQUIRE(t.sequence == next_seq[s]++);
+        CHECK(t.mono_ts_ns >= t.sequence * 1'000'000ull);
+        CHECK(t.mono_ts_ns < (t.sequence + 1) * 1'000'000ull);
+        CHECK(t.bid < t.ask);
+    }
+}
+
+TEST_CASE("Offline generation requires a bounded, seeded run", "[offline]")
+{
+    auto params = universe(2);
+    params.seed = 0;
+    CHECK_THROWS_AS(ts::generate_offline(params, ts::OfflineOptions{.steps = 10}), std::invalid_argument);
+    params.seed = 1;
+    params.max_count = 0;
+    CHECK_THROWS_AS(ts::generate_offline(params, ts::OfflineOptions{}), std::invalid_argument);
+    params.rate_hz = 3e9; // step below 1ns
+    CHECK_THROWS_AS(ts::generate_offline(params, ts::OfflineOptions{.steps = 10}), std::invalid_argument);
+}
+
+TEST_CASE("Worker task exceptions are rethrown on the waiting thread", "[offline]")
+{
+    ts::detail::WorkStealingPool pool(3);
+    std::atomic<std::size_t> ran{0};
+    const auto batch = pool.submit(16, [&](std::size_t i) {
+        ran.fetch_add(1);
+        if (i % 5 == 2) throw std::runtime_error("task failed");
+    });
+    CHECK_THROWS_AS(pool.wait(*batch), std::runtime_error);
+    CHECK(batch->done());
+    CHECK(ran.load() == 16); // the rest of the batch still ran
+
+    // the pool stays usable afterwards
+    std::atomic<std::size_t> sum{0};
+    pool.run(8, [&](std::size_t i) { sum.fetch_add(i); });
+    CHECK(sum.load() == 28);
+}
+
+TEST_CASE("Offline generation propagates a throwing sink", "[offline]")
+{
+    ts::OfflineOptions options;
+    options.steps = 200;
+    options.threads = 2;
+    options.symbols_per_shard = 2;
+    options.steps_per_window = 10;
+    std::size_t calls = 0;
+    CHECK_THROWS_AS(ts::generate_offline(universe(6), options, [&](std::span<const ts::FlatTick>) {
+        if (++calls == 3) throw std::runtime_error("sink full");
+    }), std::runtime_error);
+    CHECK(calls == 3);
+}
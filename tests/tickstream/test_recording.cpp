@@ -0,0 +1,120 @@
+// tests/tickstream/test_recording.cpp
+#include "catch_amalgamated.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+// internal includes
+#include <tickstream/recording.hpp>
+#include <tickstream/stream_gen.hpp>
+
+namespace ts = tickstream; // local alias
+
+namespace {
+    std::string temp_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::vector<ts::FlatTick> sample(std::size_t n) {
+        ts::Params params;
+        params.symbols = {"AAPL", "MSFT", "NVDA"};
+        params.seed = 5;
+        ts::StreamGen gen(params);
+        std::vector<ts::FlatTick> ticks(n);
+        gen.next_batch(ticks);
+        for (std::size_t i = 0; i < n; ++i) ticks[i].mono_ts_ns = 1'000'000 + i * 100'000; // 100us apart
+        return ticks;
+    }
+}
+
+TEST_CASE("TickRecorder round-trips through the mapped TickFile", "[recording]")
+{
+    const auto path = temp_path("tickstream_roundtrip.tsc");
+    const auto ticks = sample(1000);
+    {
+        ts::TickRecorder recorder(path, 256); // several full blocks plus a partial one
+        recorder.append(ticks);
+        REQUIRE(recorder.tick_count() == 1000);
+    }
+
+    ts::TickFile file(path);
+    REQUIRE(file.size() == 1000);
+    REQUIRE(file.block_count() == 4);
+    REQUIRE(file.block(3).count == 1000 - 3 * 256);
+
+    std::size_t i = 0;
+    for (std::size_t b = 0; b < file.block_count(); ++b) {
+        for (std::size_t r = 0; r < file.block(b).count; ++r, ++i) {
+            const auto t = file.flat_at(b, r);
+            REQUIRE(t.price == ticks[i].price);
+            REQUIRE(t.ask == ticks[i].ask);
+            REQUIRE(t.mono_ts_ns == ticks[i].mono_ts_ns);
+            REQUIRE(t.sequence == ticks[i].sequence);
+            REQUIRE(t.symbol_id == ticks[i].symbol_id);
+        }
+    }
+    REQUIRE(file.tick_at(0, 1).symbol == "MSFT");
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("replay pushes every tick at max speed and paces at 1x", "[recording]")
+{
+    const auto path = temp_path("tickstream_replay.tsc");
+    {
+        ts::TickRecorder recorder(path);
+        recorder.append(sample(200)); // spans 19.9ms of recorded time
+    }
+    ts::TickFile file(path);
+
+    ts::RingBuffer<ts::Tick> ring(256);
+    REQUIRE(ts::replay(file, ring, {.speed = 0.0}) == 200);
+    REQUIRE(ring.size() == 200);
+    ring.clear();
+
+    ts::RingBuffer<ts::FlatTick> flat(256);
+    const auto t0 = std::chrono::steady_clock::now();
+    REQUIRE(ts::replay(file, flat, {.speed = 1.0}) == 200);
+    const auto elapsed = std::chrono::steady_clock::now() - t0;
+    REQUIRE(elapsed >= std::chrono::microseconds(19'900));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("TickFile rejects foreign files", "[recording]")
+{
+    const auto path = temp_path("tickstream_bad.tsc");
+    {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        const char junk[128] = "not a tick file";
+        std::fwrite(junk, 1, sizeof(junk), f);
+        std::fclose(f);
+    }
+    REQUIRE_THROWS_AS(ts::TickFile(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("TickFile validates tick_count and symbol indices at open", "[recording]")
+{
+    const auto path = temp_path("tickstream_tampered.tsc");
+    const auto patch = [&](std::size_t offset, auto value) {
+        {
+            ts::TickRecorder recorder(path, 64);
+            recorder.append(sample(100));
+        }
+        std::FILE* f = std::fopen(path.c_str(), "r+b");
+        std::fseek(f, static_cast<long>(offset), SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, f);
+        std::fclose(f);
+    };
+
+    patch(offsetof(ts::recording::FileHeader, tick_count), std::uint64_t{101});
+    REQUIRE_THROWS_AS(ts::TickFile(path), std::runtime_error);
+
+    patch(offsetof(ts::recording::FileHeader, symbol_count), std::uint32_t{1}); // rows still use ids 1 and 2
+    REQUIRE_THROWS_AS(ts::TickFile(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
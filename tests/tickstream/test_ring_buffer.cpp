@@ -0,0 +1,113 @@
+// tests/tickstream/test_ring_buffer.cpp
+#include "catch_amalgamated.hpp"
+
+#include <array>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// internal includes
+#include <tickstream/ring_buffer.hpp>
+
+namespace ts = tickstream; // local alias
+
+TEST_CASE("RingBuffer rounds capacity to a power of two", "[ring_buffer]")
+{
+    ts::RingBuffer<int> rb(1000);
+    REQUIRE(rb.capacity() == 1024);
+    REQUIRE(rb.empty());
+
+    ts::RingBuffer<int> tiny(0);
+    REQUIRE(tiny.capacity() == 1);
+}
+
+TEST_CASE("RingBuffer push/pop until full and empty", "[ring_buffer]")
+{
+    ts::RingBuffer<int> rb(4);
+    for (int i = 0; i < 4; ++i) REQUIRE(rb.try_push(i));
+    REQUIRE(rb.full());
+    REQUIRE_FALSE(rb.try_push(99));
+
+    int v = -1;
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(rb.try_pop(v));
+        REQUIRE(v == i);
+    }
+    REQUIRE_FALSE(rb.try_pop(v));
+    REQUIRE(rb.empty());
+}
+
+TEST_CASE("RingBuffer bulk ops wrap around", "[ring_buffer]")
+{
+    ts::RingBuffer<int> rb(8);
+    std::array<int, 6> in{};
+    std::iota(in.begin(), in.end(), 0);
+    std::array<int, 6> out{};
+
+    // advance sequences so the next batch straddles the wrap point
+    REQUIRE(rb.try_push_n(in) == 6);
+    REQUIRE(rb.try_pop_n(out) == 6);
+
+    std::iota(in.begin(), in.end(), 10);
+    REQUIRE(rb.try_push_n(in) == 6);
+    REQUIRE(rb.try_push_n(in) == 2); // only two slots left
+    REQUIRE(rb.size() == 8);
+
+    REQUIRE(rb.try_pop_n(out) == 6);
+    REQUIRE(out == std::array<int, 6>{10, 11, 12, 13, 14, 15});
+    REQUIRE(rb.try_pop_n(out) == 2);
+    REQUIRE(out[0] == 10);
+    REQUIRE(out[1] == 11);
+}
+
+TEST_CASE("RingBuffer claim/commit and peek/release", "[ring_buffer]")
+{
+    ts::RingBuffer<int> rb(4);
+
+    int* slot = rb.try_claim();
+    REQUIRE(slot != nullptr);
+    *slot = 42;
+    REQUIRE(rb.empty()); // not visible before commit
+    rb.commit();
+
+    auto run = rb.try_claim_n(8);
+    REQUIRE(run.size() == 3); // stops at the wrap point
+    run[0] = 1;
+    rb.commit(1);
+
+    int* front = rb.try_peek();
+    REQUIRE(front != nullptr);
+    REQUIRE(*front == 42);
+    rb.release();
+
+    auto view = rb.try_peek_n(4);
+    REQUIRE(view.size() == 1);
+    REQUIRE(view[0] == 1);
+    rb.release(view.size());
+    REQUIRE(rb.empty());
+}
+
+TEST_CASE("RingBuffer preserves order across threads", "[ring_buffer]")
+{
+    constexpr std::size_t count = 200000;
+    ts::RingBuffer<std::size_t> rb(256);
+
+    std::thread producer([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            while (!rb.try_push(i)) std::this_thread::yield();
+        }
+    });
+
+    std::vector<std::size_t> batch(32);
+    std::size_t expected = 0;
+    bool in_order = true;
+    while (expected < count) {
+        const std::size_t n = rb.try_pop_n(batch);
+        if (n == 0) { std::this_thread::yield(); continue; }
+        for (std::size_t i = 0; i < n; ++i) in_order &= (batch[i] == expected++);
+    }
+    producer.join();
+
+    REQUIRE(in_order);
+    REQUIRE(rb.empty());
+}
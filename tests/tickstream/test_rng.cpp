@@ -0,0 +1,99 @@
+// tests/tickstream/test_rng.cpp
+#include "catch_amalgamated.hpp"
+
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+// internal includes
+#include <tickstream/detail/rng.h>
+#include <tickstream/detail/models.hpp>
+
+namespace ts = tickstream; // local alias
+
+TEST_CASE("Philox4x32-10 matches the Random123 known-answer vector", "[rng]")
+{
+    const auto out = ts::detail::Philox4x32::block({0, 0, 0, 0}, {0, 0});
+    REQUIRE(out[0] == 0x6627e8d5u);
+    REQUIRE(out[1] == 0xe169c58du);
+    REQUIRE(out[2] == 0xbc57ac4cu);
+    REQUIRE(out[3] == 0x9b00dbd8u);
+}
+
+TEST_CASE("RNG output does not depend on batch size", "[rng]")
+{
+    ts::detail::RNG bulk(7);
+    std::vector<double> all(1000);
+    bulk.fill_normal(all);
+
+    ts::detail::RNG pieces(7);
+    std::vector<double> parts;
+    for (std::size_t chunk : {1u, 3u, 64u, 65u, 200u, 667u}) {
+        std::vector<double> v(chunk);
+        pieces.fill_normal(v);
+        parts.insert(parts.end(), v.begin(), v.end());
+    }
+
+    ts::detail::RNG scalar(7);
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        REQUIRE(all[i] == parts[i]);
+        REQUIRE(all[i] == scalar.normal(0.0, 1.0));
+    }
+}
+
+TEST_CASE("RNG lanes address substreams directly", "[rng]")
+{
+    const ts::detail::RNG root(11);
+    std::vector<double> lanes(100);
+    root.uniform_lanes(lanes, 5, 3); // draw #3 of streams 5..104
+
+    for (std::size_t i = 0; i < lanes.size(); ++i) {
+        auto s = root.substream(5 + i);
+        s.seek(3);
+        REQUIRE(lanes[i] == s.uniform(0.0, 1.0));
+    }
+
+    auto a = root.substream(1), b = root.substream(2);
+    REQUIRE(a.uniform(0.0, 1.0) != b.uniform(0.0, 1.0));
+}
+
+TEST_CASE("RNG distributions have the expected moments", "[rng]")
+{
+    ts::detail::RNG rng(123);
+    constexpr std::size_t n = 200000;
+
+    std::vector<double> z(n);
+    rng.fill_normal(z, 1.0, 2.0);
+    const double mean = std::accumulate(z.begin(), z.end(), 0.0) / n;
+    double var = 0.0;
+    for (double x : z) var += (x - mean) * (x - mean);
+    var /= n;
+    REQUIRE(std::abs(mean - 1.0) < 0.02);
+    REQUIRE(std::abs(var - 4.0) < 0.08);
+
+    std::vector<double> u(n);
+    rng.fill_uniform(u);
+    REQUIRE(std::abs(std::accumulate(u.begin(), u.end(), 0.0) / n - 0.5) < 0.005);
+
+    for (double lambda : {0.05, 4.0, 50.0}) {
+        std::vector<int> k(n);
+        rng.fill_poisson(k, lambda);
+        const double m = std::accumulate(k.begin(), k.end(), 0.0) / n;
+        REQUIRE(std::abs(m - lambda) < 0.02 * lambda + 0.005);
+    }
+}
+
+TEST_CASE("Engine paths do not depend on how symbols are sharded", "[rng]")
+{
+    ts::Params params;
+    params.seed = 99;
+
+    ts::detail::MultiSymbolEngine whole(params, 8, params.seed);
+    ts::detail::MultiSymbolEngine shard(params, 3, params.seed, 4); // symbols 4..6
+
+    for (int step = 0; step < 50; ++step) {
+        whole.step();
+        shard.step();
+        for (std::size_t i = 0; i < 3; ++i) REQUIRE(whole.price()[4 + i] == shard.price()[i]);
+    }
+}
@@ -0,0 +1,87 @@
+// tests/tickstream/test_scheduler.cpp
+#include "catch_amalgamated.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+// internal includes
+#include <tickstream/scheduler.hpp>
+#include <tickstream/stream.hpp>
+
+namespace ts = tickstream; // local alias
+using namespace std::chrono_literals;
+
+TEST_CASE("Scheduler drives many tasks from one thread without drift", "[scheduler]")
+{
+    ts::Scheduler scheduler({.threads = 1, .mode = ts::PacingMode::Hybrid});
+
+    constexpr int tasks = 500;
+    std::atomic<int> fired{0};
+    for (int i = 0; i < tasks; ++i) {
+        scheduler.add([&] { fired.fetch_add(1, std::memory_order_relaxed); }, 5ms);
+    }
+    REQUIRE(scheduler.size() == tasks);
+
+    const auto started = std::chrono::steady_clock::now();
+    scheduler.start();
+    std::this_thread::sleep_for(500ms);
+    scheduler.stop();
+    const auto periods = (std::chrono::steady_clock::now() - started) / 5ms; // ~100, more if the sleep overran
+
+    // no drift: never more than one fire per elapsed period, and only scheduling slack missing
+    REQUIRE(fired.load() <= tasks * (periods + 1));
+    REQUIRE(fired.load() >= tasks * (periods * 9 / 10));
+}
+
+TEST_CASE("Scheduler interval_for rejects rates without a representable period", "[scheduler]")
+{
+    REQUIRE(ts::Scheduler::interval_for(1000.0) == 1ms);
+    for (double bad : {0.0, -5.0, std::nan(""), std::numeric_limits<double>::infinity(), 1e-12}) {
+        REQUIRE_THROWS_AS(ts::Scheduler::interval_for(bad), std::invalid_argument);
+    }
+
+    ts::TickStream stream(16);
+    ts::Params params;
+    params.rate_hz = 0.0;
+    REQUIRE_THROWS_AS(stream.add_symbol("S", ts::tick_btc, params), std::invalid_argument);
+}
+
+TEST_CASE("Scheduler remove stops a task", "[scheduler]")
+{
+    ts::Scheduler scheduler({.threads = 2});
+    std::atomic<int> a{0}, b{0};
+    const auto id_a = scheduler.add([&] { ++a; }, 1ms);
+    scheduler.add([&] { ++b; }, 1ms);
+    scheduler.start();
+
+    std::this_thread::sleep_for(20ms);
+    scheduler.remove(id_a);
+    const int frozen = a.load();
+    std::this_thread::sleep_for(20ms);
+    scheduler.stop();
+
+    REQUIRE(a.load() == frozen);
+    REQUIRE(b.load() > frozen);
+}
+
+TEST_CASE("TickStream paces symbols through the shared scheduler", "[scheduler]")
+{
+    ts::TickStream stream(1024);
+    ts::Params params;
+    params.rate_hz = 200.0;
+    params.latency_jitter_ms = 1.0;
+
+    for (int i = 0; i < 20; ++i) stream.add_symbol("S" + std::to_string(i), ts::tick_btc, params);
+    stream.start();
+    std::this_thread::sleep_for(100ms);
+    stream.stop();
+
+    // 20 symbols x ~20 periods
+    const auto produced = stream.merger().size();
+    REQUIRE(produced >= 20 * 15);
+    REQUIRE(produced <= 20 * 21);
+}
@@ -0,0 +1,253 @@
+// tests/tickstream/test_shm_transport.cpp
+#include "catch_amalgamated.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// internal includes
+#include <tickstream/shm_transport.hpp>
+#include <tickstream/tick.hpp>
+
+namespace ts = tickstream; // local alias
+using namespace std::chrono_literals;
+
+namespace {
+    std::string feed_name(const char* tag) {
+        return "tickstream-test-" + std::string(tag) + "-" + std::to_string(::getpid());
+    }
+
+    ts::FlatTick tick(std::uint32_t sequence) {
+        ts::FlatTick t{};
+        t.sequence = sequence;
+        t.price = sequence;
+        return t;
+    }
+
+    ts::ShmOptions small(std::size_t capacity = 64) {
+        ts::ShmOptions options;
+        options.capacity = capacity;
+        options.max_subscribers = 4;
+        return options;
+    }
+}
+
+TEST_CASE("Shm subscribers each see every element and gate the publisher", "[shm]")
+{
+    const auto name = feed_name("fanout");
+    ts::ShmPublisher<ts::FlatTick> pub(name, small());
+    ts::ShmSubscriber<ts::FlatTick> a(name), b(name);
+    REQUIRE(pub.subscribers() == 2);
+
+    std::uint32_t s = 0;
+    while (pub.try_publish(tick(s))) ++s;
+    CHECK(s == 64); // a full ring behind the slowest subscriber
+
+    std::vector<std::uint32_t> got_a;
+    REQUIRE(a.poll([&](const ts::FlatTick& t) { got_a.push_back(t.sequence); }) == 64);
+    CHECK(got_a.front() == 0);
+    CHECK(got_a.back() == 63);
+    CHECK_FALSE(pub.try_publish(tick(s))); // b has not moved
+
+    REQUIRE(b.poll([](const ts::FlatTick&) {}, 10) == 10);
+    for (int k = 0; k < 10; ++k) REQUIRE(pub.try_publish(tick(s++)));
+    CHECK_FALSE(pub.try_publish(tick(s)));
+    CHECK(b.lag() == 64);
+}
+
+TEST_CASE("Shm attach handshake validates the segment", "[shm]")
+{
+    const auto name = feed_name("handshake");
+    CHECK_THROWS_AS(ts::ShmSubscriber<ts::FlatTick>(name), std::runtime_error);
+
+    ts::ShmPublisher<ts::FlatTick> pub(name, small());
+    CHECK_THROWS_AS(ts::ShmSubscriber<std::uint64_t>(name), std::runtime_error); // element size mismatch
+
+    ts::ShmSubscriber<ts::FlatTick> sub(name);
+    CHECK(sub.connected());
+    pub.publish(tick(1));
+    CHECK(sub.poll([](const ts::FlatTick&) {}) == 1);
+
+    // late joiners start at the live cursor
+    ts::ShmSubscriber<ts::FlatTick> late(name);
+    CHECK(late.position() == 1);
+    CHECK(late.poll([](const ts::FlatTick&) {}) == 0);
+}
+
+TEST_CASE("Shm subscribers survive a publisher restart on the same segment", "[shm]")
+{
+    const auto name = feed_name("restart");
+    auto options = small();
+    options.unlink_on_close = false;
+
+    auto pub = std::make_unique<ts::ShmPublisher<ts::FlatTick>>(name, options);
+    ts::ShmSubscriber<ts::FlatTick> sub(name);
+    for (std::uint32_t s = 0; s < 5; ++s) pub->publish(tick(s));
+    pub.reset();
+    CHECK_FALSE(sub.connected());
+
+    pub = std::make_unique<ts::ShmPublisher<ts::FlatTick>>(name, options);
+    CHECK(sub.connected());
+    CHECK(pub->cursor() == 5);
+    pub->publish(tick(5));
+
+    std::vector<std::uint32_t> got;
+    sub.poll([&](const ts::FlatTick& t) { got.push_back(t.sequence); });
+    CHECK(got == std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5});
+    CHECK(sub.reconnects() == 1);
+
+    // a publisher with a different layout replaces the segment; reconnect() re-attaches
+    pub.reset();
+    auto bigger = options;
+    bigger.capacity = 128;
+    pub = std::make_unique<ts::ShmPublisher<ts::FlatTick>>(name, bigger);
+    sub.reconnect();
+    CHECK(sub.capacity() == 128);
+    pub->publish(tick(9));
+    CHECK(sub.poll([](const ts::FlatTick& t) { CHECK(t.sequence == 9); }) == 1);
+    ts::ShmPublisher<ts::FlatTick>::unlink(name);
+}
+
+TEST_CASE("Shm transport crosses a process boundary with a blocking subscriber", "[shm]")
+{
+    const auto name = feed_name("fork");
+    constexpr std::uint32_t count = 20000;
+    ts::ShmPublisher<ts::FlatTick> pub(name, small(256));
+
+    const pid_t child = ::fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        int status = 1;
+        try {
+            ts::ShmSubscriber<ts::FlatTick> sub(name, ts::WaitKind::Blocking);
+            std::atomic<bool> running{true};
+            std::uint32_t expected = 0;
+            bool ordered = true;
+            while (expected < count && sub.wait(running)) {
+                sub.poll([&](const ts::FlatTick& t) { ordered = ordered && t.sequence == expected++; });
+            }
+            status = ordered && expected == count ? 0 : 2;
+        } catch (...) {
+            status = 3;
+        }
+        ::_exit(status);
+    }
+
+    while (pub.subscribers() == 0) std::this_thread::sleep_for(1ms);
+    for (std::uint32_t s = 0; s < count; ++s) {
+        pub.publish(tick(s));
+        if (s % 4096 == 0) std::this_thread::sleep_for(1ms); // let the subscriber park on the futex
+    }
+
+    int status = 0;
+    REQUIRE(::waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == 0);
+
+    // the child detached cleanly; a subscriber that dies attached is reaped instead
+    const pid_t crashed = ::fork();
+    if (crashed == 0) {
+        new ts::ShmSubscriber<ts::FlatTick>(name); // never detached
+        ::_exit(0);
+    }
+    ::waitpid(crashed, &status, 0);
+    REQUIRE(pub.subscribers() == 1);
+    for (std::uint32_t s = 0; s < 1000; ++s) pub.publish(tick(s)); // would block forever without reaping
+    CHECK(pub.subscribers() == 0);
+}
+
+TEST_CASE("Shm publisher refuses a segment owned by a live publisher of any layout", "[shm]")
+{
+    const auto name = feed_name("owned");
+    int ready[2], release[2];
+    REQUIRE(::pipe(ready) == 0);
+    REQUIRE(::pipe(release) == 0);
+
+    const pid_t child = ::fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        char c = 0;
+        {
+            ts::ShmPublisher<ts::FlatTick> pub(name, small());
+            (void)!::write(ready[1], &c, 1);
+            (void)!::read(release[0], &c, 1);
+        }
+        ::_exit(0);
+    }
+
+    char c = 0;
+    REQUIRE(::read(ready[0], &c, 1) == 1);
+    CHECK_THROWS_AS(ts::ShmPublisher<ts::FlatTick>(name, small()), std::runtime_error);
+    CHECK_THROWS_AS(ts::ShmPublisher<ts::FlatTick>(name, small(128)), std::runtime_error); // different size
+    CHECK_THROWS_AS(ts::ShmPublisher<std::uint64_t>(name, small()), std::runtime_error);   // different layout
+
+    REQUIRE(::write(release[1], &c, 1) == 1);
+    int status = 0;
+    REQUIRE(::waitpid(child, &status, 0) == child);
+    for (int fd : {ready[0], ready[1], release[0], release[1]}) ::close(fd);
+}
+
+TEST_CASE("Shm subscriber that fails to reconnect leaves the new segment alone", "[shm]")
+{
+    const auto name = feed_name("bad-reconnect");
+    auto pub = std::make_unique<ts::ShmPublisher<ts::FlatTick>>(name, small());
+    auto stale = std::make_unique<ts::ShmSubscriber<ts::FlatTick>>(name); // slot 0 of the first segment
+    pub.reset();
+
+    // replacement segment: another subscriber takes slot 0, then the header goes bad
+    pub = std::make_unique<ts::ShmPublisher<ts::FlatTick>>(name, small(128));
+    ts::ShmSubscriber<ts::FlatTick> live(name);
+    REQUIRE(pub->subscribers() == 1);
+    {
+        const int fd = ::shm_open(("/" + name).c_str(), O_RDWR, 0);
+        REQUIRE(fd >= 0);
+        void* map = ::mmap(nullptr, sizeof(ts::ShmHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        REQUIRE(map != MAP_FAILED);
+        static_cast<ts::ShmHeader*>(map)->version = ts::shm_version + 1;
+        ::munmap(map, sizeof(ts::ShmHeader));
+    }
+
+    CHECK_THROWS_AS(stale->reconnect(), std::runtime_error);
+    stale.reset();                  // must not release slot 0 of the new segment
+    CHECK(pub->subscribers() == 1);
+}
+
+TEST_CASE("Shm publisher reclaims a slot whose owner died before going active", "[shm]")
+{
+    const auto name = feed_name("claimed");
+    auto options = small();
+    options.max_subscribers = 1;
+    ts::ShmPublisher<ts::FlatTick> pub(name, options);
+
+    const pid_t dead = ::fork();
+    REQUIRE(dead >= 0);
+    if (dead == 0) ::_exit(0);
+    int status = 0;
+    REQUIRE(::waitpid(dead, &status, 0) == dead);
+
+    // what a subscriber killed between its claim and going active leaves behind
+    {
+        const int fd = ::shm_open(("/" + name).c_str(), O_RDWR, 0);
+        REQUIRE(fd >= 0);
+        const std::size_t bytes = sizeof(ts::ShmHeader) + sizeof(ts::ShmSubscriberSlot);
+        void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        REQUIRE(map != MAP_FAILED);
+        auto* slot = reinterpret_cast<ts::ShmSubscriberSlot*>(static_cast<std::byte*>(map) + sizeof(ts::ShmHeader));
+        slot->pid.store(dead);
+        slot->state.store(ts::ShmSubscriberSlot::claimed);
+        ::munmap(map, bytes);
+    }
+
+    CHECK_THROWS_AS(ts::ShmSubscriber<ts::FlatTick>(name), std::runtime_error); // no free slot
+    CHECK(pub.reap() == 1);
+    ts::ShmSubscriber<ts::FlatTick> sub(name);
+    CHECK(pub.subscribers() == 1);
+}
@@ -0,0 +1,104 @@
+// tests/tickstream/test_stats.cpp
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// internal includes
+#include <tickstream/stats.hpp>
+#include <tickstream/stream.hpp>
+
+namespace ts = tickstream; // local alias
+using namespace std::chrono_literals;
+
+TEST_CASE("LatencyHistogram buckets are contiguous and bounded", "[stats]")
+{
+    using H = ts::LatencyHistogram;
+    for (std::uint64_t v : {0ull, 1ull, 31ull, 32ull, 33ull, 63ull, 64ull, 1000ull, 123456789ull, ~0ull}) {
+        const auto i = H::index_of(v);
+        REQUIRE(i < H::bucket_count);
+        REQUIRE(v <= H::upper_bound_of(i));
+        if (i > 0) REQUIRE(v > H::upper_bound_of(i - 1));
+    }
+}
+
+TEST_CASE("LatencyHistogram bucket error stays within the documented bound", "[stats]")
+{
+    using H = ts::LatencyHistogram;
+    REQUIRE(H::max_relative_error == 0.0625);
+    double worst = 0.0;
+    const auto check = [&](std::uint64_t v) {
+        const double err = static_cast<double>(H::upper_bound_of(H::index_of(v)) - v) / static_cast<double>(v);
+        REQUIRE(err <= H::max_relative_error);
+        worst = std::max(worst, err);
+    };
+    for (std::uint64_t v = 1; v <= (1u << 16); ++v) check(v);
+    for (unsigned shift = 17; shift < 64; ++shift) {
+        const std::uint64_t base = std::uint64_t{1} << shift;
+        for (std::uint64_t v : {base, base + 1, base + base / 3, 2 * base - 1}) check(v);
+    }
+    REQUIRE(worst > 0.06); // the bound is tight at the bottom of each octave
+}
+
+TEST_CASE("LatencyHistogram percentiles stay within bucket precision", "[stats]")
+{
+    ts::LatencyHistogram h;
+    for (std::uint64_t v = 1; v <= 100000; ++v) h.record(v);
+
+    REQUIRE(h.count() == 100000);
+    REQUIRE(h.max() == 100000);
+    const auto p50 = static_cast<double>(h.percentile(0.5));
+    const auto p99 = static_cast<double>(h.percentile(0.99));
+    REQUIRE(std::abs(p50 - 50000.0) / 50000.0 < 0.04);
+    REQUIRE(std::abs(p99 - 99000.0) / 99000.0 < 0.04);
+    REQUIRE(h.percentile(1.0) == 100000);
+}
+
+TEST_CASE("ShardedCounter aggregates across threads", "[stats]")
+{
+    ts::ShardedCounter c;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] { for (int i = 0; i < 10000; ++i) c.add(); });
+    }
+    for (auto& t : threads) t.join();
+    REQUIRE(c.load() == 40000);
+}
+
+TEST_CASE("TickStream populates Stats from producers and the consumer", "[stats]")
+{
+    ts::TickStream stream(64);
+    stream.add_symbol("BTC-USD", ts::tick_btc, 1ms);
+    stream.add_symbol("ETH-USD", ts::tick_btc, 2ms);
+
+    std::atomic<int> snapshots{0};
+    stream.set_stats_hook([&](const ts::TickStream::Stats& s) {
+        if (s.symbols.size() == 2) ++snapshots;
+    }, 10ms);
+
+    ts::Consumer<ts::Tick> consumer;
+    consumer.set_stats(stream.stream_stats());
+    consumer.set_wait_strategy(stream.wait_strategy());
+
+    std::atomic<bool> running{true};
+    std::thread t([&] { consumer.process_continuous(stream.merger(), running); });
+    stream.start();
+    std::this_thread::sleep_for(60ms);
+    stream.stop();
+    running = false;
+    stream.wait_strategy().wake_all();
+    t.join();
+
+    const auto stats = stream.get_stats();
+    REQUIRE(stats.total_ticks_produced > 0);
+    REQUIRE(stats.total_ticks_consumed == stats.total_ticks_produced - stats.buffer_drops);
+    REQUIRE(stats.latency_samples == stats.total_ticks_consumed);
+    REQUIRE(stats.latency_p50_ns <= stats.latency_max_ns);
+    REQUIRE(stats.symbols.size() == 2);
+    for (const auto& s : stats.symbols) REQUIRE(s.produce_rate_hz > 0.0);
+    REQUIRE(snapshots.load() >= 3);
+}
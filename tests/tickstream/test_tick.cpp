@@ -4,6 +4,9 @@
 
 // internal includes
 #include <tickstream/tick.hpp>
+#include <tickstream/symbols.hpp>
+#include <tickstream/ring_buffer.hpp>
+#include <tickstream/consumer.hpp>
 
 namespace ts = tickstream; // local alias
 
@@ -18,4 +21,62 @@ TEST_CASE("Tick Creation Test", "[tick]")
     REQUIRE(tick_2.unix_ts_ns > 0);
     REQUIRE(tick_1.price > 0);
     REQUIRE(tick_2.price > 0);
-}
\ No newline at end of file
+}
+TEST_CASE("FlatTick round-trips through the rich Tick", "[tick]")
+{
+    ts::SymbolRegistry registry;
+    auto tick = ts::tick_btc();
+    tick.bids = {{64999.5, 2.0}, {64999.0, 3.0}};
+    tick.asks = {{65000.5, 1.0}};
+
+    const ts::FlatTick flat = ts::to_flat(tick, registry);
+    REQUIRE(flat.symbol_id == registry.intern("BTC-USD"));
+    REQUIRE(flat.n_bids == 2);
+    REQUIRE(flat.n_asks == 1);
+
+    const ts::Tick back = ts::to_tick(flat, registry);
+    REQUIRE(back.symbol == "BTC-USD");
+    REQUIRE(back.price == tick.price);
+    REQUIRE(back.mono_ts_ns == tick.mono_ts_ns);
+    REQUIRE(back.bids == tick.bids);
+    REQUIRE(back.asks == tick.asks);
+}
+
+TEST_CASE("FlatTick truncates depth beyond the inline capacity", "[tick]")
+{
+    ts::SymbolRegistry registry;
+    auto tick = ts::tick_btc();
+    for (std::size_t i = 0; i < ts::flat_depth + 3; ++i) tick.bids.emplace_back(100.0 - i, 1.0);
+
+    const ts::FlatTick flat = ts::to_flat(tick, registry);
+    REQUIRE(flat.n_bids == ts::flat_depth);
+    REQUIRE(ts::to_tick(flat, registry).bids.size() == ts::flat_depth);
+}
+
+TEST_CASE("SymbolRegistry interns names to dense ids", "[tick]")
+{
+    ts::SymbolRegistry registry;
+    REQUIRE(registry.intern("AAPL") == 0);
+    REQUIRE(registry.intern("MSFT") == 1);
+    REQUIRE(registry.intern("AAPL") == 0);
+    REQUIRE(registry.name(1) == "MSFT");
+    REQUIRE_FALSE(registry.find("TSLA").has_value());
+    REQUIRE(registry.size() == 2);
+}
+
+TEST_CASE("FlatTick flows through RingBuffer and Consumer", "[tick]")
+{
+    ts::RingBuffer<ts::FlatTick> buffer(8);
+    ts::Consumer<ts::FlatTick> consumer;
+
+    double seen = 0.0;
+    consumer.subscribe([&](const ts::FlatTick& t) { seen += t.price; });
+
+    auto flat = ts::to_flat(ts::tick_btc());
+    REQUIRE(buffer.try_push(flat));
+    REQUIRE(buffer.try_push(flat));
+    consumer.process(buffer);
+
+    REQUIRE(seen == 2 * flat.price);
+    REQUIRE(buffer.empty());
+}
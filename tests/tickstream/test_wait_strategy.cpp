@@ -0,0 +1,202 @@
+// tests/tickstream/test_wait_strategy.cpp
+#include "catch_amalgamated.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// internal includes
+#include <tickstream/consumer.hpp>
+#include <tickstream/producer.hpp>
+#include <tickstream/scheduler.hpp>
+#include <tickstream/ring_buffer.hpp>
+#include <tickstream/stream.hpp>
+#include <tickstream/tick.hpp>
+#include <tickstream/wait_strategy.hpp>
+
+namespace ts = tickstream; // local alias
+using namespace std::chrono_literals;
+
+TEST_CASE("Wait strategies hand off every element", "[wait]")
+{
+    for (auto kind : {ts::WaitKind::BusySpin, ts::WaitKind::SpinYield, ts::WaitKind::Blocking}) {
+        constexpr int count = 20000;
+        ts::RingBuffer<int> buffer(1024);
+        ts::WaitStrategy wait(kind, 16);
+        std::atomic<bool> running{true};
+
+        ts::Consumer<int> consumer;
+        consumer.set_wait_strategy(wait);
+        long long sum = 0;
+        consumer.subscribe([&](const int& v) { sum += v; });
+        std::thread t([&] { consumer.process_continuous(buffer, running); });
+
+        for (int i = 0; i < count; ++i) {
+            if (!buffer.try_push(i)) {
+                wait.wait([&] { return buffer.try_push(i); }, running);
+            }
+            wait.signal();
+        }
+        while (!buffer.empty()) std::this_thread::yield();
+        running = false;
+        wait.wake_all();
+        t.join();
+
+        REQUIRE(sum == static_cast<long long>(count) * (count - 1) / 2);
+    }
+}
+
+TEST_CASE("Blocking wait returns false when stopped", "[wait]")
+{
+    ts::WaitStrategy wait(ts::WaitKind::Blocking, 0);
+    std::atomic<bool> running{true};
+    std::atomic<bool> result{true};
+
+    std::thread t([&] { result = wait.wait([] { return false; }, running); });
+    std::this_thread::sleep_for(10ms);
+    running = false;
+    wait.wake_all();
+    t.join();
+    REQUIRE_FALSE(result.load());
+}
+
+TEST_CASE("Overwritable ring keeps the newest elements", "[wait]")
+{
+    ts::RingBuffer<int> ring(4, true);
+    int evicted = 0;
+    for (int i = 0; i < 10; ++i) evicted += ring.push_overwrite(i) ? 0 : 1;
+    REQUIRE(evicted == 6);
+
+    std::vector<int> out(8);
+    REQUIRE(ring.try_pop_n(out) == 4);
+    REQUIRE(out[0] == 6);
+    REQUIRE(out[3] == 9);
+}
+
+TEST_CASE("Producer counts drops and overwrites per policy", "[wait]")
+{
+    int next = 0;
+    auto gen = [&] { return next++; };
+
+    SECTION("Block holds one tick without stalling the shared scheduler thread") {
+        ts::Scheduler scheduler;
+        ts::RingBuffer<int> buffer(4);
+        ts::Producer<int> producer(scheduler, buffer, gen, 200us);
+        std::atomic<int> other{0};
+        scheduler.add([&] { ++other; }, 200us);
+        producer.start();
+        scheduler.start();
+        std::this_thread::sleep_for(20ms);
+
+        REQUIRE(producer.back_pressured());
+        REQUIRE(producer.produced() == 5); // 4 queued + 1 held
+        REQUIRE(other.load() > 20);        // the shard kept running other tasks
+
+        int v = -1;
+        REQUIRE(buffer.try_pop(v));
+        REQUIRE(v == 0);
+        std::this_thread::sleep_for(5ms);
+        REQUIRE(producer.produced() == 6); // held tick went in, next one is held
+        producer.stop();
+        scheduler.stop();
+        REQUIRE(producer.dropped() == 1);  // held when stopped
+        REQUIRE_FALSE(producer.back_pressured());
+    }
+
+    SECTION("DropNewest") {
+        ts::RingBuffer<int> buffer(4);
+        ts::Producer<int> producer(buffer, gen, 200us);
+        producer.set_overflow_policy(ts::OverflowPolicy::DropNewest);
+        producer.start();
+        std::this_thread::sleep_for(20ms);
+        producer.stop();
+
+        REQUIRE(buffer.size() == 4);
+        REQUIRE(producer.dropped() == producer.produced() - 4);
+        int v = -1;
+        REQUIRE(buffer.try_pop(v));
+        REQUIRE(v == 0); // oldest kept
+    }
+
+    SECTION("OverwriteOldest") {
+        ts::RingBuffer<int> buffer(4, true);
+        ts::Producer<int> producer(buffer, gen, 200us);
+        producer.set_overflow_policy(ts::OverflowPolicy::OverwriteOldest);
+        producer.start();
+        std::this_thread::sleep_for(20ms);
+        producer.stop();
+
+        REQUIRE(producer.overwritten() == producer.produced() - 4);
+        int v = -1;
+        REQUIRE(buffer.try_pop(v));
+        REQUIRE(v == static_cast<int>(producer.produced()) - 4); // newest kept
+    }
+
+    SECTION("OverwriteOldest needs an overwritable ring") {
+        ts::RingBuffer<int> buffer(4);
+        ts::Producer<int> producer(buffer, gen, 1ms);
+        REQUIRE_THROWS_AS(producer.set_overflow_policy(ts::OverflowPolicy::OverwriteOldest), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Overwritable ring never hands out a torn element", "[wait]")
+{
+    struct Wide { std::uint64_t v[8]; }; // every word carries the same value
+    ts::RingBuffer<Wide> ring(8, true);
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        for (std::uint64_t i = 1; i <= 200000; ++i) {
+            Wide w;
+            for (auto& x : w.v) x = i;
+            ring.push_overwrite(w);
+        }
+        done = true;
+    });
+
+    std::uint64_t last = 0, popped = 0;
+    bool consistent = true, ordered = true;
+    Wide w;
+    while (!done.load() || !ring.empty()) {
+        if (!ring.try_pop(w)) continue;
+        ++popped;
+        for (auto x : w.v) consistent = consistent && x == w.v[0];
+        ordered = ordered && w.v[0] > last;
+        last = w.v[0];
+    }
+    producer.join();
+
+    REQUIRE(popped > 0);
+    REQUIRE(consistent);
+    REQUIRE(ordered);
+    REQUIRE(last == 200000);
+}
+
+TEST_CASE("FlatTickStream lanes honour OverwriteOldest", "[wait]")
+{
+    ts::TickStream rich(4);
+    REQUIRE_THROWS_AS(rich.set_overflow_policy(ts::OverflowPolicy::OverwriteOldest), std::invalid_argument);
+
+    ts::FlatTickStream stream(4);
+    stream.set_overflow_policy(ts::OverflowPolicy::OverwriteOldest);
+    std::uint32_t seq = 0;
+    stream.add_symbol("AAA", [&] {
+        ts::FlatTick t{};
+        t.sequence = seq++;
+        t.mono_ts_ns = ts::StreamStats::now_ns();
+        return t;
+    }, 200us);
+    REQUIRE(stream.lane("AAA").overwritable());
+
+    stream.start();
+    std::this_thread::sleep_for(20ms);
+    stream.stop();
+
+    const auto& producer = stream.producer("AAA");
+    REQUIRE(producer.overwritten() == producer.produced() - 4);
+    ts::FlatTick t{};
+    REQUIRE(stream.lane("AAA").try_pop(t));
+    REQUIRE(t.sequence == producer.produced() - 4); // newest kept
+}